@@ -1,4 +1,5 @@
 #pragma once
+#include <Core/coroutine.hpp>
 #include <Core/engine_types.hpp>
 #include <Core/math/vector.hpp>
 #include <Engine/Render/deferred_renderer.hpp>
@@ -10,7 +11,8 @@ namespace Trinex
 	class EditorRenderer : public DeferredRenderer
 	{
 	public:
-		static Actor* static_raycast(const SceneView& view, Vector2f uv, RenderScene* scene);
+		// Completes on the logic thread once the GPU has finished rendering the hit proxies
+		static Coroutine<Actor*> static_raycast(const SceneView& view, Vector2f uv, RenderScene* scene);
 
 	public:
 		EditorRenderer(const SceneView& view, ViewMode mode = ViewMode::Lit);
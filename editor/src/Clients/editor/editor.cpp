@@ -903,16 +903,20 @@ namespace Trinex
 		return *this;
 	}
 
-	EditorClientOLD& EditorClientOLD::select_actors(const Vector2f& uv)
+	static Coroutine<void> select_actor_at(Pointer<World> world, SceneView view, Vector2f uv)
 	{
-		Actor* actor = EditorRenderer::static_raycast(m_scene_view, uv, m_world->scene());
+		Actor* actor = co_await EditorRenderer::static_raycast(view, uv, world->scene());
 
 		auto editor = EditorEngine::instance();
-		editor->unselect(m_world);
+		editor->unselect(world);
 
 		if (actor)
 			editor->select(actor);
+	}
 
+	EditorClientOLD& EditorClientOLD::select_actors(const Vector2f& uv)
+	{
+		select_actor_at(m_world, m_scene_view, uv);
 		return *this;
 	}
 
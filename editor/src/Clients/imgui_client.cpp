@@ -1,6 +1,7 @@
 #include <Clients/imgui_client.hpp>
 #include <Core/etl/templates.hpp>
 #include <Core/localization.hpp>
+#include <Core/memory_tracker.hpp>
 #include <Core/reflection/class.hpp>
 #include <Core/string_functions.hpp>
 #include <Core/threading.hpp>
@@ -185,6 +186,7 @@ namespace Trinex
 
 	ImGuiViewportClient& ImGuiViewportClient::update(class RenderViewport* viewport, float dt)
 	{
+		trinex_memory_tag(Editor);
 		Super::update(viewport, dt);
 
 		m_window->new_frame();
@@ -18,6 +18,7 @@
 #include <Graphics/material_bindings.hpp>
 #include <Graphics/render_pools.hpp>
 #include <Graphics/render_surface.hpp>
+#include <RHI/awaitables.hpp>
 #include <RHI/context.hpp>
 #include <RHI/rhi.hpp>
 
@@ -87,7 +88,7 @@ namespace Trinex
 
 	EditorRenderer::EditorRenderer(const SceneView& view, ViewMode mode) : DeferredRenderer(view, mode) {}
 
-	Actor* EditorRenderer::static_raycast(const SceneView& view, Vector2f uv, RenderScene* scene)
+	Coroutine<Actor*> EditorRenderer::static_raycast(const SceneView& view, Vector2f uv, RenderScene* scene)
 	{
 		uv = glm::clamp(uv, Vector2f(0.f), Vector2f(1.f));
 		HitproxyRenderer renderer(view);
@@ -116,7 +117,8 @@ namespace Trinex
 
 		RHI::instance()->submit(fence);
 
-		while (!fence->is_signaled()) Thread::static_yield();
+		co_await *fence;
+		co_await resume_on(logic_thread());
 
 		u8* data     = buffer->map(RHIMappingAccess::Read);
 		Actor* actor = *reinterpret_cast<Actor**>(data);
@@ -124,7 +126,7 @@ namespace Trinex
 
 		RHIFencePool::global_instance()->release(fence);
 		RHIBufferPool::global_instance()->release(buffer);
-		return actor;
+		co_return actor;
 	}
 
 	EditorRenderer& EditorRenderer::render_grid()
@@ -1,6 +1,7 @@
 #include <Core/etl/algorithm.hpp>
 #include <Core/file_manager.hpp>
 #include <Core/filesystem/root_filesystem.hpp>
+#include <Core/memory_tracker.hpp>
 #include <Core/reflection/class.hpp>
 #include <Graphics/render_viewport.hpp>
 #include <UI/Elements/document.hpp>
@@ -134,6 +135,7 @@ namespace Trinex::UI
 
 	Client& Client::update(class RenderViewport* viewport, float dt)
 	{
+		trinex_memory_tag(Editor);
 		Super::update(viewport, dt);
 
 		ImGui::SetCurrentContext(m_ctx);
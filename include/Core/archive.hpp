@@ -1,7 +1,9 @@
 #pragma once
 #include <Core/enums.hpp>
+#include <Core/etl/map.hpp>
 #include <Core/etl/string.hpp>
 #include <Core/etl/type_traits.hpp>
+#include <Core/etl/vector.hpp>
 
 namespace Trinex
 {
@@ -36,7 +38,45 @@ namespace Trinex
 		bool serialize_struct(Refl::Struct* self, void* obj);
 
 	public:
+		// Unique full names of the objects referenced by serialize_object_ref. If an import table is set, references are
+		// serialized as indices into it, so that the table can be stored before the data and dependencies can be loaded ahead
+		struct ImportTable {
+			static constexpr u32 none = ~0U;
+
+			Vector<String> paths;
+			Map<String, u32> indices;// Used only while saving
+
+			u32 add(const String& path);
+		};
+
+		// Layouts of the reflected structs serialized by the archive. If a schema table is set, reflected properties are
+		// serialized by the compiled plans of the structs without names, the stored layout is used only to read data which
+		// was saved with an older layout of the struct
+		struct SchemaTable {
+			struct Field {
+				String name;
+				u32 size;// Size of the trivially copyable value, or zero if the value is stored with the size prefix
+
+				bool serialize(Archive& ar);
+			};
+
+			struct Schema {
+				String name;
+				u64 hash;
+				Vector<Field> fields;
+
+				bool serialize(Archive& ar);
+			};
+
+			Vector<Schema> schemas;
+			Map<Refl::Struct*, u32> indices;// Used only while saving
+
+			u32 add(Refl::Struct* self, const Schema& schema);
+		};
+
 		SerializationFlags flags;
+		ImportTable* imports = nullptr;
+		SchemaTable* schemas = nullptr;
 
 		Archive();
 		Archive(BufferReader* reader);
@@ -60,7 +60,8 @@ namespace Trinex
 		static void push_array_argument(const String& name, const String& argument);
 		static String parse_string_argument(const char* argument, usize* out_pos = nullptr);
 
-		static Map<String, Argument> m_arguments;
+		// find() returns pointers to the elements
+		static NodeMap<String, Argument> m_arguments;
 		static i32 m_argc;
 		static const char** m_argv;
 
@@ -69,7 +70,7 @@ namespace Trinex
 		static i32 argc();
 		static const char** argv();
 		static void clear();
-		static const Map<String, Argument>& args();
+		static const NodeMap<String, Argument>& args();
 		static Argument* find(const String& name);
 		static void push_argument(const Argument& argument, bool override = false);
 	};
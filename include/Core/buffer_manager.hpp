@@ -46,6 +46,10 @@ namespace Trinex
 		virtual BufferReader& offset(PosOffset offset, BufferSeekDir dir = BufferSeekDir::Current) = 0;
 		virtual bool is_open() const                                                               = 0;
 
+		// Returns the next size bytes without copying them and moves the position past them.
+		// Readers which don't keep the data in memory return nullptr, the data must be read with read in this case
+		virtual const u8* read_view(usize size) { return nullptr; }
+
 		template<typename... T>
 		FORCE_INLINE bool read_primitives(T&... value)
 		{
@@ -155,6 +159,19 @@ namespace Trinex
 			return true;
 		}
 
+		const u8* read_view(usize size) override
+		{
+			usize required_size = (m_read_pos + size + sizeof(T) - 1) / sizeof(T);
+			if (m_buffer->size() < required_size)
+			{
+				return nullptr;
+			}
+
+			const u8* view = reinterpret_cast<const u8*>(m_buffer->data()) + m_read_pos;
+			m_read_pos += size;
+			return view;
+		}
+
 		bool is_open() const override { return true; }
 	};
 
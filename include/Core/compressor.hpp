@@ -5,4 +5,5 @@ namespace Trinex::Compressor
 {
 	ENGINE_EXPORT void compress(const Buffer& src, Buffer& dst);
 	ENGINE_EXPORT void decompress(const Buffer& src, Buffer& dst);
+	ENGINE_EXPORT void decompress(const u8* src, usize size, Buffer& dst);
 }// namespace Trinex::Compressor
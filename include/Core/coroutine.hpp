@@ -0,0 +1,248 @@
+#pragma once
+#include <Core/etl/atomic.hpp>
+#include <Core/etl/optional.hpp>
+#include <Core/threading.hpp>
+#include <coroutine>
+#include <exception>
+
+namespace Trinex
+{
+	template<typename T = void>
+	class Coroutine;
+
+	namespace Detail
+	{
+		// Submits the task to the TaskGraph at the beginning of the next frame
+		ENGINE_EXPORT void add_task_next_frame(Task&& task);
+
+		class CoroutinePromiseBase
+		{
+		private:
+			static inline void* completed_marker() { return reinterpret_cast<void*>(usize(1)); }
+
+			// nullptr while running, completed_marker() after completion, otherwise address of the awaiting coroutine
+			Atomic<void*> m_continuation = nullptr;
+
+			// One reference is owned by the coroutine frame, another one by the Coroutine object
+			Atomic<u32> m_refs = 2;
+
+		public:
+			struct FinalAwaiter {
+				bool await_ready() noexcept { return false; }
+
+				template<typename Promise>
+				std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+				{
+					auto& promise                = handle.promise();
+					void* continuation           = promise.m_continuation.exchange(completed_marker(), etl::memory_order_acq_rel);
+					std::coroutine_handle<> next = std::noop_coroutine();
+
+					if (continuation)
+						next = std::coroutine_handle<>::from_address(continuation);
+
+					if (promise.release())
+						handle.destroy();
+
+					return next;
+				}
+
+				void await_resume() noexcept {}
+			};
+
+			std::suspend_never initial_suspend() noexcept { return {}; }
+			FinalAwaiter final_suspend() noexcept { return {}; }
+			void unhandled_exception() noexcept { std::terminate(); }
+
+			inline bool is_done() const { return m_continuation.load(etl::memory_order_acquire) == completed_marker(); }
+
+			// Returns false if the coroutine is already completed, and the awaiter must not suspend
+			inline bool set_continuation(std::coroutine_handle<> handle)
+			{
+				void* expected = nullptr;
+				return m_continuation.compare_exchange_strong(expected, handle.address(), etl::memory_order_acq_rel);
+			}
+
+			// Returns true if this was the last reference
+			inline bool release() { return m_refs.fetch_sub(1, etl::memory_order_acq_rel) == 1; }
+		};
+
+		template<typename T>
+		class CoroutinePromise : public CoroutinePromiseBase
+		{
+		private:
+			Optional<T> m_value;
+
+		public:
+			Coroutine<T> get_return_object();
+
+			template<typename U>
+			void return_value(U&& value)
+			{
+				m_value.emplace(etl::forward<U>(value));
+			}
+
+			inline T& result() { return *m_value; }
+		};
+
+		template<>
+		class CoroutinePromise<void> : public CoroutinePromiseBase
+		{
+		public:
+			Coroutine<void> get_return_object();
+			void return_void() {}
+			inline void result() {}
+		};
+	}// namespace Detail
+
+	// Eagerly started coroutine. Destroying the Coroutine object detaches the coroutine, it keeps running until completion
+	template<typename T>
+	class Coroutine final
+	{
+	public:
+		using promise_type = Detail::CoroutinePromise<T>;
+		using Handle       = std::coroutine_handle<promise_type>;
+
+	private:
+		Handle m_handle;
+
+	public:
+		explicit Coroutine(Handle handle = nullptr) : m_handle(handle) {}
+		Coroutine(const Coroutine&)            = delete;
+		Coroutine& operator=(const Coroutine&) = delete;
+
+		Coroutine(Coroutine&& other) : m_handle(other.m_handle) { other.m_handle = nullptr; }
+
+		Coroutine& operator=(Coroutine&& other)
+		{
+			if (this != &other)
+			{
+				detach();
+				m_handle       = other.m_handle;
+				other.m_handle = nullptr;
+			}
+			return *this;
+		}
+
+		inline bool is_valid() const { return m_handle != nullptr; }
+		inline bool is_done() const { return m_handle && m_handle.promise().is_done(); }
+
+		// Can be called only after completion
+		inline decltype(auto) result()
+		{
+			trinex_assert(is_done());
+			return m_handle.promise().result();
+		}
+
+		void detach()
+		{
+			if (m_handle && m_handle.promise().release())
+				m_handle.destroy();
+
+			m_handle = nullptr;
+		}
+
+		~Coroutine() { detach(); }
+
+		struct Awaiter {
+			Handle handle;
+
+			bool await_ready() const { return handle.promise().is_done(); }
+			bool await_suspend(std::coroutine_handle<> awaiter) { return handle.promise().set_continuation(awaiter); }
+			decltype(auto) await_resume() { return handle.promise().result(); }
+		};
+
+		Awaiter operator co_await() const& { return Awaiter{m_handle}; }
+	};
+
+	template<typename T>
+	inline Coroutine<T> Detail::CoroutinePromise<T>::get_return_object()
+	{
+		return Coroutine<T>(Coroutine<T>::Handle::from_promise(*this));
+	}
+
+	inline Coroutine<void> Detail::CoroutinePromise<void>::get_return_object()
+	{
+		return Coroutine<void>(Coroutine<void>::Handle::from_promise(*this));
+	}
+
+	// Suspends until the task is executed, and resumes on a TaskGraph worker. The task is submitted if it wasn't yet.
+	struct TaskAwaiter {
+		Task task;
+
+		bool await_ready() const { return task.is_executed(); }
+
+		bool await_suspend(std::coroutine_handle<> handle)
+		{
+			return TaskGraph::instance()->add_continuation(task, Task(task.priority(), [handle]() { handle.resume(); }));
+		}
+
+		void await_resume() const {}
+	};
+
+	// Task is implicitly constructible from any callable, so the operator must not accept conversions
+	template<typename TaskType>
+	    requires(std::is_same_v<std::decay_t<TaskType>, Task>)
+	inline TaskAwaiter operator co_await(TaskType&& task)
+	{
+		return TaskAwaiter{etl::forward<TaskType>(task)};
+	}
+
+	// Resumes the coroutine on the specified thread, for example co_await resume_on(logic_thread())
+	struct ThreadAwaiter {
+		Thread* thread;
+		Task::Priority priority;
+
+		bool await_ready() const { return thread == this_thread(); }
+		void await_suspend(std::coroutine_handle<> handle) { thread->add_task(Task(priority, [handle]() { handle.resume(); })); }
+		void await_resume() const {}
+	};
+
+	inline ThreadAwaiter resume_on(Thread* thread, Task::Priority priority = Task::High)
+	{
+		return ThreadAwaiter{thread, priority};
+	}
+
+	// Resumes the coroutine on a TaskGraph worker
+	struct TaskGraphAwaiter {
+		TaskGraph* graph;
+		Task::Priority priority;
+
+		bool await_ready() const { return false; }
+		void await_suspend(std::coroutine_handle<> handle) { graph->add_task(Task(priority, [handle]() { handle.resume(); })); }
+		void await_resume() const {}
+	};
+
+	inline TaskGraphAwaiter resume_on(TaskGraph* graph, Task::Priority priority = Task::Middle)
+	{
+		return TaskGraphAwaiter{graph, priority};
+	}
+
+	// Suspends until predicate returns true. The predicate is polled by a TaskGraph worker once per frame,
+	// no thread is blocked or spinning while waiting
+	template<typename Predicate>
+	struct PollAwaiter {
+		Predicate predicate;
+		Task::Priority priority = Task::Middle;
+
+		static void poll(std::coroutine_handle<> handle, Predicate& predicate, Task::Priority priority)
+		{
+			Detail::add_task_next_frame(Task(priority, [handle, predicate = etl::move(predicate), priority]() mutable {
+				if (predicate())
+					handle.resume();
+				else
+					poll(handle, predicate, priority);
+			}));
+		}
+
+		bool await_ready() { return predicate(); }
+		void await_suspend(std::coroutine_handle<> handle) { poll(handle, predicate, priority); }
+
+		void await_resume() const {}
+	};
+
+	template<typename Predicate>
+	inline PollAwaiter<std::decay_t<Predicate>> wait_until(Predicate&& predicate, Task::Priority priority = Task::Middle)
+	{
+		return PollAwaiter<std::decay_t<Predicate>>{etl::forward<Predicate>(predicate), priority};
+	}
+}// namespace Trinex
@@ -26,10 +26,23 @@ namespace Trinex
 		}
 	};
 
+	// General purpose allocator. Small allocations are served from thread-local size class caches backed by TLSF arenas,
+	// large ones from the system allocator. Setting TRINEX_ALLOCATOR=system before startup routes everything to the system
 	struct ENGINE_EXPORT ByteAllocator : AllocatorBase {
+		struct Statistics {
+			size_type arenas             = 0;// Number of TLSF arenas
+			size_type reserved_bytes     = 0;// Memory reserved by TLSF arenas
+			size_type used_bytes         = 0;// Bytes allocated from arenas, including blocks kept in thread caches
+			size_type cache_hits         = 0;// Allocations served by thread caches
+			size_type cache_misses       = 0;// Allocations that refilled thread caches from arenas
+			size_type system_allocations = 0;// Allocations served by the system allocator
+		};
+
 		static inline unsigned char* allocate(size_type size) { return allocate_aligned(size, 16); }
 		static unsigned char* allocate_aligned(size_type size, size_type align);
 		static void deallocate(unsigned char* ptr) noexcept;
+		static Statistics statistics();
+		static const char* backend();
 	};
 
 	struct ENGINE_EXPORT StackByteAllocator : AllocatorBase {
@@ -57,11 +70,18 @@ namespace Trinex
 		static void location(u128 value);
 	};
 
+	// Per-thread ring of frame arenas. Memory allocated during frame N stays valid until frame N + frames_in_flight() begins,
+	// so it may be consumed by the pipelined frames. frames_in_flight() follows Settings::Rendering::frames_in_flight.
+	// Reset only advances the global frame index, every thread recycles its retired frames lazily on the next allocation
 	struct ENGINE_EXPORT FrameByteAllocator : AllocatorBase {
+		static constexpr u32 max_frames_in_flight = 8;
+
 		static inline unsigned char* allocate(size_type size) { return allocate_aligned(size, 16); }
 		static inline void deallocate(unsigned char*) noexcept {}
 		static unsigned char* allocate_aligned(size_type size, size_type align);
 		static void reset();
+		static u64 frame_index();
+		static u32 frames_in_flight();
 	};
 
 	template<typename T, typename Type>
@@ -0,0 +1,121 @@
+#pragma once
+#include <Core/engine_types.hpp>
+#include <Core/etl/atomic.hpp>
+#include <Core/etl/allocator.hpp>
+
+namespace Trinex
+{
+	// Bounded lock-free multi-producer multi-consumer queue (Vyukov).
+	// Every cell carries a sequence number, so producers and consumers only contend on their own cursor.
+	template<typename Type>
+	class ConcurrentQueue final
+	{
+		static_assert(std::is_trivially_copyable_v<Type>, "ConcurrentQueue supports only trivially copyable types");
+
+	private:
+		struct Cell {
+			Atomic<usize> sequence;
+			Type value;
+		};
+
+		Cell* m_cells;
+		usize m_mask;
+
+		alignas(64) Atomic<usize> m_enqueue = 0;
+		alignas(64) Atomic<usize> m_dequeue = 0;
+
+	public:
+		explicit ConcurrentQueue(usize capacity = 4096)
+		{
+			usize size = 2;
+			while (size < capacity) size <<= 1;
+
+			m_mask  = size - 1;
+			m_cells = reinterpret_cast<Cell*>(ByteAllocator::allocate_aligned(sizeof(Cell) * size, 64));
+
+			for (usize i = 0; i < size; ++i)
+			{
+				new (m_cells + i) Cell();
+				m_cells[i].sequence.store(i, etl::memory_order_relaxed);
+			}
+		}
+
+		ConcurrentQueue(const ConcurrentQueue&)            = delete;
+		ConcurrentQueue& operator=(const ConcurrentQueue&) = delete;
+
+		bool push(Type value)
+		{
+			usize pos = m_enqueue.load(etl::memory_order_relaxed);
+
+			while (true)
+			{
+				Cell* cell     = m_cells + (pos & m_mask);
+				usize sequence = cell->sequence.load(etl::memory_order_acquire);
+				isize diff     = static_cast<isize>(sequence) - static_cast<isize>(pos);
+
+				if (diff == 0)
+				{
+					if (m_enqueue.compare_exchange_weak(pos, pos + 1, etl::memory_order_relaxed))
+					{
+						cell->value = value;
+						cell->sequence.store(pos + 1, etl::memory_order_release);
+						return true;
+					}
+				}
+				else if (diff < 0)
+				{
+					return false;
+				}
+				else
+				{
+					pos = m_enqueue.load(etl::memory_order_relaxed);
+				}
+			}
+		}
+
+		bool pop(Type& out)
+		{
+			usize pos = m_dequeue.load(etl::memory_order_relaxed);
+
+			while (true)
+			{
+				Cell* cell     = m_cells + (pos & m_mask);
+				usize sequence = cell->sequence.load(etl::memory_order_acquire);
+				isize diff     = static_cast<isize>(sequence) - static_cast<isize>(pos + 1);
+
+				if (diff == 0)
+				{
+					if (m_dequeue.compare_exchange_weak(pos, pos + 1, etl::memory_order_relaxed))
+					{
+						out = cell->value;
+						cell->sequence.store(pos + m_mask + 1, etl::memory_order_release);
+						return true;
+					}
+				}
+				else if (diff < 0)
+				{
+					return false;
+				}
+				else
+				{
+					pos = m_dequeue.load(etl::memory_order_relaxed);
+				}
+			}
+		}
+
+		inline usize size() const
+		{
+			usize enqueue = m_enqueue.load(etl::memory_order_relaxed);
+			usize dequeue = m_dequeue.load(etl::memory_order_relaxed);
+			return enqueue > dequeue ? enqueue - dequeue : 0;
+		}
+
+		inline bool empty() const { return size() == 0; }
+
+		~ConcurrentQueue()
+		{
+			for (usize i = 0; i <= m_mask; ++i) m_cells[i].~Cell();
+			ByteAllocator::deallocate(reinterpret_cast<u8*>(m_cells));
+		}
+	};
+}// namespace Trinex
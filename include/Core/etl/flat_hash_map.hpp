@@ -0,0 +1,84 @@
+#pragma once
+#include <Core/etl/flat_hash_table.hpp>
+
+namespace Trinex
+{
+	// Open addressing hash map, see Detail::FlatHash::Table. Unlike std::unordered_map, element addresses are not stable:
+	// use NodeMap if references to the elements must survive insertions
+	template<typename Key, typename Value, typename HashType = Hash<Key>, typename Pred = std::equal_to<Key>,
+	         typename AllocatorType = Allocator<Pair<const Key, Value>>>
+	class FlatHashMap
+	    : public Detail::FlatHash::Table<Detail::FlatHash::MapPolicy<Key, Value>, HashType, Pred, AllocatorType, false>
+	{
+	private:
+		using Super = Detail::FlatHash::Table<Detail::FlatHash::MapPolicy<Key, Value>, HashType, Pred, AllocatorType, false>;
+
+	public:
+		using mapped_type    = Value;
+		using iterator       = typename Super::iterator;
+		using const_iterator = typename Super::const_iterator;
+
+		using Super::Super;
+		using Super::operator=;
+
+		template<typename... Args>
+		Pair<iterator, bool> try_emplace(const Key& key, Args&&... args)
+		{
+			return Super::try_emplace_key(key, std::forward<Args>(args)...);
+		}
+
+		template<typename... Args>
+		Pair<iterator, bool> try_emplace(Key&& key, Args&&... args)
+		{
+			return Super::try_emplace_key(std::move(key), std::forward<Args>(args)...);
+		}
+
+		template<typename KeyType, typename ValueType>
+		    requires(std::is_same_v<std::decay_t<KeyType>, Key>)
+		Pair<iterator, bool> emplace(KeyType&& key, ValueType&& value)
+		{
+			return Super::try_emplace_key(std::forward<KeyType>(key), std::forward<ValueType>(value));
+		}
+
+		using Super::emplace;
+
+		template<typename ValueType>
+		Pair<iterator, bool> insert_or_assign(const Key& key, ValueType&& value)
+		{
+			auto result = Super::try_emplace_key(key, std::forward<ValueType>(value));
+
+			if (!result.second)
+				result.first->second = std::forward<ValueType>(value);
+
+			return result;
+		}
+
+		template<typename ValueType>
+		Pair<iterator, bool> insert_or_assign(Key&& key, ValueType&& value)
+		{
+			auto result = Super::try_emplace_key(std::move(key), std::forward<ValueType>(value));
+
+			if (!result.second)
+				result.first->second = std::forward<ValueType>(value);
+
+			return result;
+		}
+
+		Value& operator[](const Key& key) { return Super::try_emplace_key(key).first->second; }
+		Value& operator[](Key&& key) { return Super::try_emplace_key(std::move(key)).first->second; }
+
+		Value& at(const Key& key)
+		{
+			auto it = Super::find(key);
+			trinex_assert_msg(it != Super::end(), "Key is not present in the map");
+			return it->second;
+		}
+
+		const Value& at(const Key& key) const
+		{
+			auto it = Super::find(key);
+			trinex_assert_msg(it != Super::end(), "Key is not present in the map");
+			return it->second;
+		}
+	};
+}// namespace Trinex
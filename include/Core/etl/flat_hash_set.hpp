@@ -0,0 +1,19 @@
+#pragma once
+#include <Core/etl/flat_hash_table.hpp>
+
+namespace Trinex
+{
+	// Open addressing hash set, see Detail::FlatHash::Table. Unlike std::unordered_set, element addresses are not stable:
+	// use NodeSet if references to the elements must survive insertions
+	template<typename Type, typename HashType = Hash<Type>, typename Pred = std::equal_to<Type>,
+	         typename AllocatorType = Allocator<Type>>
+	class FlatHashSet : public Detail::FlatHash::Table<Detail::FlatHash::SetPolicy<Type>, HashType, Pred, AllocatorType, true>
+	{
+	private:
+		using Super = Detail::FlatHash::Table<Detail::FlatHash::SetPolicy<Type>, HashType, Pred, AllocatorType, true>;
+
+	public:
+		using Super::Super;
+		using Super::operator=;
+	};
+}// namespace Trinex
@@ -0,0 +1,792 @@
+#pragma once
+#include <Core/etl/allocator.hpp>
+#include <Core/etl/bit.hpp>
+#include <Core/etl/hash.hpp>
+#include <Core/etl/pair.hpp>
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TRINEX_FLAT_HASH_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define TRINEX_FLAT_HASH_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace Trinex
+{
+	namespace Detail::FlatHash
+	{
+		// Every slot has a control byte: 0b0hhhhhhh for full slots, where h are 7 bits of the hash, or one of the special values
+		using Control = i8;
+
+		static constexpr Control ctrl_empty    = -128;// 0b10000000
+		static constexpr Control ctrl_deleted  = -2;  // 0b11111110
+		static constexpr Control ctrl_sentinel = -1;  // 0b11111111
+
+		FORCE_INLINE bool is_full(Control ctrl)
+		{
+			return ctrl >= 0;
+		}
+
+		FORCE_INLINE bool is_empty_or_deleted(Control ctrl)
+		{
+			return ctrl < ctrl_sentinel;
+		}
+
+		// Set of slots of a group, every slot is represented by (1 << shift) bits of the mask
+		template<typename MaskType, u32 width, u32 shift>
+		class BitMask
+		{
+		private:
+			MaskType m_mask;
+
+		public:
+			explicit BitMask(MaskType mask) : m_mask(mask) {}
+
+			explicit operator bool() const { return m_mask != 0; }
+			u32 operator*() const { return trailing_zeros(); }
+			bool operator!=(const BitMask& other) const { return m_mask != other.m_mask; }
+
+			BitMask& operator++()
+			{
+				m_mask &= m_mask - 1;
+				return *this;
+			}
+
+			BitMask begin() const { return *this; }
+			BitMask end() const { return BitMask(0); }
+
+			u32 trailing_zeros() const { return static_cast<u32>(etl::countr_zero(m_mask)) >> shift; }
+
+			u32 leading_zeros() const
+			{
+				constexpr u32 unused_bits = sizeof(MaskType) * 8 - (width << shift);
+				return static_cast<u32>(etl::countl_zero(m_mask) - unused_bits) >> shift;
+			}
+		};
+
+#if TRINEX_FLAT_HASH_SSE2
+		struct Group {
+			static constexpr usize width = 16;
+			using Mask                   = BitMask<u32, width, 0>;
+
+			__m128i ctrl;
+
+			explicit Group(const Control* pos) : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))) {}
+
+			Mask match(u8 h2) const { return Mask(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(h2)), ctrl))); }
+			Mask match_empty() const { return Mask(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(ctrl_empty), ctrl))); }
+
+			Mask match_empty_or_deleted() const
+			{
+				return Mask(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(ctrl_sentinel), ctrl)));
+			}
+
+			u32 count_leading_empty_or_deleted() const
+			{
+				const u32 mask = _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(ctrl_sentinel), ctrl));
+				return etl::countr_zero(mask + 1);
+			}
+		};
+#elif TRINEX_FLAT_HASH_NEON
+		struct Group {
+			static constexpr usize width = 8;
+			static constexpr u64 msbs    = 0x8080808080808080ULL;
+			using Mask                   = BitMask<u64, width, 3>;
+
+			int8x8_t ctrl;
+
+			explicit Group(const Control* pos) : ctrl(vld1_s8(pos)) {}
+
+			static FORCE_INLINE u64 to_mask(uint8x8_t value) { return vget_lane_u64(vreinterpret_u64_u8(value), 0) & msbs; }
+
+			Mask match(u8 h2) const { return Mask(to_mask(vceq_s8(ctrl, vdup_n_s8(static_cast<i8>(h2))))); }
+			Mask match_empty() const { return Mask(to_mask(vceq_s8(ctrl, vdup_n_s8(ctrl_empty)))); }
+			Mask match_empty_or_deleted() const { return Mask(to_mask(vcgt_s8(vdup_n_s8(ctrl_sentinel), ctrl))); }
+
+			u32 count_leading_empty_or_deleted() const
+			{
+				const u64 mask = ~to_mask(vcgt_s8(vdup_n_s8(ctrl_sentinel), ctrl)) & msbs;
+				return mask ? etl::countr_zero(mask) >> 3 : width;
+			}
+		};
+#else
+		// Portable implementation, processes 8 control bytes packed into an integer
+		struct Group {
+			static_assert(etl::endian::native == etl::endian::little, "Portable group implementation requires little endian");
+
+			static constexpr usize width = 8;
+			static constexpr u64 lsbs    = 0x0101010101010101ULL;
+			static constexpr u64 msbs    = 0x8080808080808080ULL;
+			using Mask                   = BitMask<u64, width, 3>;
+
+			u64 ctrl;
+
+			explicit Group(const Control* pos) { std::memcpy(&ctrl, pos, sizeof(ctrl)); }
+
+			// May report false positives next to a real match, keys are compared anyway
+			Mask match(u8 h2) const
+			{
+				const u64 value = ctrl ^ (lsbs * h2);
+				return Mask((value - lsbs) & ~value & msbs);
+			}
+
+			Mask match_empty() const { return Mask((ctrl & ~(ctrl << 6)) & msbs); }
+			Mask match_empty_or_deleted() const { return Mask((ctrl & ~(ctrl << 7)) & msbs); }
+
+			u32 count_leading_empty_or_deleted() const
+			{
+				return static_cast<u32>(etl::countr_zero((ctrl | ~(ctrl >> 7)) & lsbs)) >> 3;
+			}
+		};
+#endif
+
+		// std::hash is an identity function for integers and pointers, so the hash is mixed before splitting into H1 and H2
+		FORCE_INLINE usize mix(usize hash)
+		{
+			const u128 product = static_cast<u128>(hash) * 0x9E3779B97F4A7C15ULL;
+			return static_cast<usize>(static_cast<u64>(product) ^ static_cast<u64>(product >> 64));
+		}
+
+		FORCE_INLINE usize h1(usize hash)
+		{
+			return hash >> 7;
+		}
+
+		FORCE_INLINE u8 h2(usize hash)
+		{
+			return static_cast<u8>(hash & 0x7F);
+		}
+
+		// Capacity is always 2^n - 1, so it can be used as a mask
+		FORCE_INLINE usize normalize_capacity(usize count)
+		{
+			return count ? ~usize(0) >> etl::countl_zero(count) : 1;
+		}
+
+		// Maximum load factor is 7/8. Group of 8 with 7 full slots has no empty slots to terminate the probing
+		FORCE_INLINE usize capacity_to_growth(usize capacity)
+		{
+			if (Group::width == 8 && capacity == 7)
+				return 6;
+			return capacity - capacity / 8;
+		}
+
+		FORCE_INLINE usize growth_to_capacity(usize growth)
+		{
+			if (Group::width == 8 && growth == 7)
+				return 8;
+			return growth + (growth - 1) / 7;
+		}
+
+		// Triangular probing over groups visits every group of the table exactly once
+		class ProbeSequence
+		{
+		private:
+			usize m_mask;
+			usize m_offset;
+			usize m_index = 0;
+
+		public:
+			ProbeSequence(usize hash, usize mask) : m_mask(mask), m_offset(hash & mask) {}
+
+			usize offset() const { return m_offset; }
+			usize offset(usize index) const { return (m_offset + index) & m_mask; }
+
+			void next()
+			{
+				m_index += Group::width;
+				m_offset = (m_offset + m_index) & m_mask;
+			}
+		};
+
+		template<typename Key, typename Value>
+		struct MapPolicy {
+			using key_type   = Key;
+			using value_type = Pair<const Key, Value>;
+
+			static FORCE_INLINE const Key& key(const value_type& value) { return value.first; }
+		};
+
+		template<typename Key>
+		struct SetPolicy {
+			using key_type   = Key;
+			using value_type = Key;
+
+			static FORCE_INLINE const Key& key(const value_type& value) { return value; }
+		};
+
+		// Open addressing hash table with SIMD group probing. Elements are stored inline in one allocation together with
+		// control bytes, so insertions may move elements: references and iterators are invalidated by any insertion which
+		// grows the table. Erasure never moves other elements.
+		template<typename Policy, typename HashType, typename Pred, typename AllocatorType, bool is_set>
+		class Table
+		{
+		public:
+			using key_type        = typename Policy::key_type;
+			using value_type      = typename Policy::value_type;
+			using size_type       = usize;
+			using difference_type = std::ptrdiff_t;
+			using hasher          = HashType;
+			using key_equal       = Pred;
+			using allocator_type  = typename std::allocator_traits<AllocatorType>::template rebind_alloc<value_type>;
+			using reference       = value_type&;
+			using const_reference = const value_type&;
+			using pointer         = value_type*;
+			using const_pointer   = const value_type*;
+
+		private:
+			using AllocatorTraits = std::allocator_traits<allocator_type>;
+
+			template<bool is_const>
+			class Iterator
+			{
+			public:
+				using iterator_category = std::forward_iterator_tag;
+				using value_type        = typename Table::value_type;
+				using difference_type   = typename Table::difference_type;
+				using reference         = std::conditional_t<is_const || is_set, const value_type&, value_type&>;
+				using pointer           = std::conditional_t<is_const || is_set, const value_type*, value_type*>;
+
+			private:
+				const Control* m_ctrl = nullptr;
+				value_type* m_slot    = nullptr;
+
+				Iterator(const Control* ctrl, value_type* slot) : m_ctrl(ctrl), m_slot(slot) {}
+
+				void skip_empty_or_deleted()
+				{
+					while (is_empty_or_deleted(*m_ctrl))
+					{
+						const u32 shift = Group(m_ctrl).count_leading_empty_or_deleted();
+						m_ctrl += shift;
+						m_slot += shift;
+					}
+				}
+
+			public:
+				Iterator() = default;
+
+				template<bool other_const>
+				    requires(is_const && !other_const)
+				Iterator(const Iterator<other_const>& other) : m_ctrl(other.m_ctrl), m_slot(other.m_slot)
+				{}
+
+				reference operator*() const { return *m_slot; }
+				pointer operator->() const { return m_slot; }
+
+				Iterator& operator++()
+				{
+					++m_ctrl;
+					++m_slot;
+					skip_empty_or_deleted();
+					return *this;
+				}
+
+				Iterator operator++(int)
+				{
+					Iterator result = *this;
+					++(*this);
+					return result;
+				}
+
+				template<bool other_const>
+				bool operator==(const Iterator<other_const>& other) const
+				{
+					return m_ctrl == other.m_ctrl;
+				}
+
+				friend class Table;
+				friend class Iterator<!is_const>;
+			};
+
+		public:
+			using iterator       = Iterator<false>;
+			using const_iterator = Iterator<true>;
+
+		private:
+			Control* m_ctrl      = nullptr;
+			value_type* m_slots  = nullptr;
+			usize m_capacity     = 0;
+			usize m_size         = 0;
+			usize m_growth_left  = 0;
+			[[no_unique_address]] HashType m_hash;
+			[[no_unique_address]] Pred m_equal;
+			[[no_unique_address]] allocator_type m_allocator;
+
+			static FORCE_INLINE usize allocation_size(usize capacity)
+			{
+				const usize ctrl_bytes = capacity + Group::width;
+				return capacity + (ctrl_bytes + sizeof(value_type) - 1) / sizeof(value_type);
+			}
+
+			FORCE_INLINE usize hash_of(const key_type& key) const { return mix(static_cast<usize>(m_hash(key))); }
+
+			// Writes control byte of the slot and its copy after the sentinel, which lets group loads skip wrapping around
+			FORCE_INLINE void set_ctrl(usize index, Control value)
+			{
+				constexpr usize cloned = Group::width - 1;
+
+				m_ctrl[index]                                                  = value;
+				m_ctrl[((index - cloned) & m_capacity) + (cloned & m_capacity)] = value;
+			}
+
+			void initialize_slots(usize capacity)
+			{
+				m_slots    = AllocatorTraits::allocate(m_allocator, allocation_size(capacity));
+				m_ctrl     = reinterpret_cast<Control*>(m_slots + capacity);
+				m_capacity = capacity;
+
+				std::memset(m_ctrl, ctrl_empty, capacity + Group::width);
+				m_ctrl[capacity] = ctrl_sentinel;
+				m_growth_left    = capacity_to_growth(capacity) - m_size;
+			}
+
+			void release_slots()
+			{
+				if (m_slots)
+				{
+					AllocatorTraits::deallocate(m_allocator, m_slots, allocation_size(m_capacity));
+				}
+
+				m_slots       = nullptr;
+				m_ctrl        = nullptr;
+				m_capacity    = 0;
+				m_growth_left = 0;
+			}
+
+			void destroy_slots()
+			{
+				if constexpr (!std::is_trivially_destructible_v<value_type>)
+				{
+					for (usize index = 0; index < m_capacity; ++index)
+					{
+						if (is_full(m_ctrl[index]))
+							AllocatorTraits::destroy(m_allocator, m_slots + index);
+					}
+				}
+			}
+
+			usize find_first_non_full(usize hash) const
+			{
+				ProbeSequence sequence(h1(hash), m_capacity);
+
+				while (true)
+				{
+					if (auto mask = Group(m_ctrl + sequence.offset()).match_empty_or_deleted())
+						return sequence.offset(mask.trailing_zeros());
+
+					sequence.next();
+				}
+			}
+
+			void resize(usize capacity)
+			{
+				Control* old_ctrl      = m_ctrl;
+				value_type* old_slots  = m_slots;
+				const usize old_capacity = m_capacity;
+
+				initialize_slots(capacity);
+
+				for (usize index = 0; index < old_capacity; ++index)
+				{
+					if (!is_full(old_ctrl[index]))
+						continue;
+
+					const usize hash   = hash_of(Policy::key(old_slots[index]));
+					const usize target = find_first_non_full(hash);
+
+					set_ctrl(target, static_cast<Control>(h2(hash)));
+					AllocatorTraits::construct(m_allocator, m_slots + target, std::move(old_slots[index]));
+					AllocatorTraits::destroy(m_allocator, old_slots + index);
+				}
+
+				if (old_slots)
+				{
+					AllocatorTraits::deallocate(m_allocator, old_slots, allocation_size(old_capacity));
+				}
+			}
+
+			void rehash_and_grow()
+			{
+				if (m_capacity == 0)
+				{
+					resize(1);
+				}
+				else if (m_size * 32 <= m_capacity * 25)
+				{
+					// Most of the growth was consumed by deleted slots, rebuilding the table with the same capacity drops them
+					resize(m_capacity);
+				}
+				else
+				{
+					resize(m_capacity * 2 + 1);
+				}
+			}
+
+			usize find_index(const key_type& key, usize hash) const
+			{
+				if (m_size == 0)
+					return m_capacity;
+
+				ProbeSequence sequence(h1(hash), m_capacity);
+				const u8 tag = h2(hash);
+
+				while (true)
+				{
+					Group group(m_ctrl + sequence.offset());
+
+					for (u32 match : group.match(tag))
+					{
+						const usize index = sequence.offset(match);
+
+						if (m_equal(Policy::key(m_slots[index]), key))
+							return index;
+					}
+
+					if (group.match_empty())
+						return m_capacity;
+
+					sequence.next();
+				}
+			}
+
+			// Marks a free slot for the new element and returns its index, caller must construct the element
+			usize prepare_insert(usize hash)
+			{
+				usize target = m_capacity ? find_first_non_full(hash) : 0;
+
+				if (m_growth_left == 0 && (m_capacity == 0 || m_ctrl[target] != ctrl_deleted))
+				{
+					rehash_and_grow();
+					target = find_first_non_full(hash);
+				}
+
+				++m_size;
+				m_growth_left -= m_ctrl[target] == ctrl_empty;
+				set_ctrl(target, static_cast<Control>(h2(hash)));
+				return target;
+			}
+
+			void erase_meta(usize index)
+			{
+				--m_size;
+
+				// If probing never went through a full group containing this slot, it can become empty again
+				const usize index_before = (index - Group::width) & m_capacity;
+				const auto empty_after   = Group(m_ctrl + index).match_empty();
+				const auto empty_before  = Group(m_ctrl + index_before).match_empty();
+
+				const bool was_never_full = empty_before && empty_after &&
+				                            (empty_after.trailing_zeros() + empty_before.leading_zeros()) < Group::width;
+
+				set_ctrl(index, was_never_full ? ctrl_empty : ctrl_deleted);
+				m_growth_left += was_never_full;
+			}
+
+			FORCE_INLINE iterator iterator_at(usize index) { return iterator(m_ctrl + index, m_slots + index); }
+
+			FORCE_INLINE const_iterator iterator_at(usize index) const
+			{
+				return const_iterator(m_ctrl + index, m_slots + index);
+			}
+
+			template<typename... Args>
+			Pair<iterator, bool> emplace_value(Args&&... args)
+			{
+				alignas(value_type) u8 storage[sizeof(value_type)];
+				value_type* value = reinterpret_cast<value_type*>(storage);
+				AllocatorTraits::construct(m_allocator, value, std::forward<Args>(args)...);
+
+				auto result = insert(std::move(*value));
+				AllocatorTraits::destroy(m_allocator, value);
+				return result;
+			}
+
+			template<typename ValueType>
+			Pair<iterator, bool> insert_value(ValueType&& value)
+			{
+				const usize hash  = hash_of(Policy::key(value));
+				const usize found = find_index(Policy::key(value), hash);
+
+				if (found != m_capacity)
+					return {iterator_at(found), false};
+
+				const usize index = prepare_insert(hash);
+				AllocatorTraits::construct(m_allocator, m_slots + index, std::forward<ValueType>(value));
+				return {iterator_at(index), true};
+			}
+
+		protected:
+			template<typename KeyType, typename... Args>
+			Pair<iterator, bool> try_emplace_key(KeyType&& key, Args&&... args)
+			{
+				const usize hash  = hash_of(key);
+				const usize found = find_index(key, hash);
+
+				if (found != m_capacity)
+					return {iterator_at(found), false};
+
+				const usize index = prepare_insert(hash);
+				AllocatorTraits::construct(m_allocator, m_slots + index, std::piecewise_construct,
+				                           std::forward_as_tuple(std::forward<KeyType>(key)),
+				                           std::forward_as_tuple(std::forward<Args>(args)...));
+				return {iterator_at(index), true};
+			}
+
+		public:
+			Table() = default;
+
+			explicit Table(usize bucket_count, const HashType& hash = HashType(), const Pred& equal = Pred(),
+			               const allocator_type& allocator = allocator_type())
+			    : m_hash(hash), m_equal(equal), m_allocator(allocator)
+			{
+				reserve(bucket_count);
+			}
+
+			explicit Table(const allocator_type& allocator) : m_allocator(allocator) {}
+
+			template<typename InputIterator>
+			Table(InputIterator first, InputIterator last, usize bucket_count = 0, const HashType& hash = HashType(),
+			      const Pred& equal = Pred(), const allocator_type& allocator = allocator_type())
+			    : Table(bucket_count, hash, equal, allocator)
+			{
+				insert(first, last);
+			}
+
+			Table(std::initializer_list<value_type> list, usize bucket_count = 0, const HashType& hash = HashType(),
+			      const Pred& equal = Pred(), const allocator_type& allocator = allocator_type())
+			    : Table(list.begin(), list.end(), bucket_count ? bucket_count : list.size(), hash, equal, allocator)
+			{}
+
+			Table(const Table& other)
+			    : m_hash(other.m_hash), m_equal(other.m_equal),
+			      m_allocator(AllocatorTraits::select_on_container_copy_construction(other.m_allocator))
+			{
+				reserve(other.size());
+				insert(other.begin(), other.end());
+			}
+
+			Table(Table&& other) noexcept
+			    : m_ctrl(other.m_ctrl), m_slots(other.m_slots), m_capacity(other.m_capacity), m_size(other.m_size),
+			      m_growth_left(other.m_growth_left), m_hash(std::move(other.m_hash)), m_equal(std::move(other.m_equal)),
+			      m_allocator(std::move(other.m_allocator))
+			{
+				other.m_ctrl        = nullptr;
+				other.m_slots       = nullptr;
+				other.m_capacity    = 0;
+				other.m_size        = 0;
+				other.m_growth_left = 0;
+			}
+
+			Table& operator=(const Table& other)
+			{
+				if (this != &other)
+				{
+					clear();
+					m_hash  = other.m_hash;
+					m_equal = other.m_equal;
+					reserve(other.size());
+					insert(other.begin(), other.end());
+				}
+				return *this;
+			}
+
+			Table& operator=(Table&& other) noexcept
+			{
+				if (this != &other)
+				{
+					Table moved(std::move(other));
+					swap(moved);
+				}
+				return *this;
+			}
+
+			Table& operator=(std::initializer_list<value_type> list)
+			{
+				clear();
+				insert(list.begin(), list.end());
+				return *this;
+			}
+
+			~Table()
+			{
+				destroy_slots();
+				release_slots();
+			}
+
+			iterator begin()
+			{
+				if (m_size == 0)
+					return end();
+
+				iterator it = iterator_at(0);
+				it.skip_empty_or_deleted();
+				return it;
+			}
+
+			const_iterator begin() const { return const_cast<Table*>(this)->begin(); }
+			const_iterator cbegin() const { return begin(); }
+			iterator end() { return iterator_at(m_capacity); }
+			const_iterator end() const { return iterator_at(m_capacity); }
+			const_iterator cend() const { return end(); }
+
+			bool empty() const { return m_size == 0; }
+			usize size() const { return m_size; }
+			usize capacity() const { return m_capacity; }
+			usize bucket_count() const { return m_capacity; }
+			usize max_size() const { return std::numeric_limits<usize>::max() / sizeof(value_type); }
+			float load_factor() const { return m_capacity ? static_cast<float>(m_size) / static_cast<float>(m_capacity) : 0.f; }
+			float max_load_factor() const { return 7.f / 8.f; }
+
+			hasher hash_function() const { return m_hash; }
+			key_equal key_eq() const { return m_equal; }
+			allocator_type get_allocator() const { return m_allocator; }
+
+			void clear()
+			{
+				if (m_capacity == 0)
+					return;
+
+				destroy_slots();
+				m_size = 0;
+
+				std::memset(m_ctrl, ctrl_empty, m_capacity + Group::width);
+				m_ctrl[m_capacity] = ctrl_sentinel;
+				m_growth_left      = capacity_to_growth(m_capacity);
+			}
+
+			void reserve(usize count)
+			{
+				if (count > m_size + m_growth_left)
+					resize(normalize_capacity(growth_to_capacity(count)));
+			}
+
+			void rehash(usize count)
+			{
+				const usize required = std::max(count, m_size ? growth_to_capacity(m_size) : usize(0));
+
+				if (required == 0)
+				{
+					if (m_size == 0)
+						release_slots();
+					return;
+				}
+
+				resize(normalize_capacity(required));
+			}
+
+			void swap(Table& other) noexcept
+			{
+				std::swap(m_ctrl, other.m_ctrl);
+				std::swap(m_slots, other.m_slots);
+				std::swap(m_capacity, other.m_capacity);
+				std::swap(m_size, other.m_size);
+				std::swap(m_growth_left, other.m_growth_left);
+				std::swap(m_hash, other.m_hash);
+				std::swap(m_equal, other.m_equal);
+				std::swap(m_allocator, other.m_allocator);
+			}
+
+			iterator find(const key_type& key) { return iterator_at(find_index(key, hash_of(key))); }
+			const_iterator find(const key_type& key) const { return iterator_at(find_index(key, hash_of(key))); }
+			bool contains(const key_type& key) const { return find_index(key, hash_of(key)) != m_capacity; }
+			usize count(const key_type& key) const { return contains(key) ? 1 : 0; }
+
+			Pair<iterator, bool> insert(const value_type& value) { return insert_value(value); }
+			Pair<iterator, bool> insert(value_type&& value) { return insert_value(std::move(value)); }
+
+			template<typename P>
+			    requires(!is_set && std::is_constructible_v<value_type, P &&>)
+			Pair<iterator, bool> insert(P&& value)
+			{
+				return emplace(std::forward<P>(value));
+			}
+
+			iterator insert(const_iterator, const value_type& value) { return insert(value).first; }
+			iterator insert(const_iterator, value_type&& value) { return insert(std::move(value)).first; }
+
+			template<typename InputIterator>
+			void insert(InputIterator first, InputIterator last)
+			{
+				for (; first != last; ++first) emplace(*first);
+			}
+
+			void insert(std::initializer_list<value_type> list) { insert(list.begin(), list.end()); }
+
+			template<typename... Args>
+			Pair<iterator, bool> emplace(Args&&... args)
+			{
+				if constexpr (sizeof...(Args) == 1 && (std::is_same_v<std::decay_t<Args>, value_type> && ...))
+				{
+					return insert(std::forward<Args>(args)...);
+				}
+				else
+				{
+					return emplace_value(std::forward<Args>(args)...);
+				}
+			}
+
+			template<typename... Args>
+			iterator emplace_hint(const_iterator, Args&&... args)
+			{
+				return emplace(std::forward<Args>(args)...).first;
+			}
+
+			iterator erase(const_iterator position)
+			{
+				const usize index = position.m_ctrl - m_ctrl;
+				AllocatorTraits::destroy(m_allocator, m_slots + index);
+				erase_meta(index);
+
+				iterator next = iterator_at(index);
+				++next;
+				return next;
+			}
+
+			iterator erase(iterator position) { return erase(const_iterator(position)); }
+
+			iterator erase(const_iterator first, const_iterator last)
+			{
+				while (first != last) first = erase(first);
+				return iterator_at(last.m_ctrl - m_ctrl);
+			}
+
+			usize erase(const key_type& key)
+			{
+				const usize index = find_index(key, hash_of(key));
+
+				if (index == m_capacity)
+					return 0;
+
+				AllocatorTraits::destroy(m_allocator, m_slots + index);
+				erase_meta(index);
+				return 1;
+			}
+
+			bool operator==(const Table& other) const
+			{
+				if (size() != other.size())
+					return false;
+
+				for (const value_type& value : *this)
+				{
+					auto it = other.find(Policy::key(value));
+
+					if (it == other.end() || !(*it == value))
+						return false;
+				}
+
+				return true;
+			}
+		};
+	}// namespace Detail::FlatHash
+}// namespace Trinex
@@ -1,6 +1,7 @@
 #pragma once
 #include <Core/etl/allocator.hpp>
 #include <Core/etl/archive_predef.hpp>
+#include <Core/etl/flat_hash_map.hpp>
 #include <Core/etl/hash.hpp>
 #include <Core/etl/pair.hpp>
 #include <map>
@@ -10,9 +11,22 @@ namespace Trinex
 {
 	class Archive;
 
+	// Node based hash map, addresses of the elements are stable until erasure
 	template<typename Key, typename Value, typename HashType = Hash<Key>, typename Pred = std::equal_to<Key>,
 	         typename AllocatorType = Allocator<Pair<const Key, Value>>>
-	using Map = std::unordered_map<Key, Value, HashType, Pred, AllocatorType>;
+	using NodeMap = std::unordered_map<Key, Value, HashType, Pred, AllocatorType>;
+
+	// TRINEX_WITH_STD_HASH_MAP switches Map back to std::unordered_map, for example to check whether an issue
+	// is caused by the invalidation of element references
+#if TRINEX_WITH_STD_HASH_MAP
+	template<typename Key, typename Value, typename HashType = Hash<Key>, typename Pred = std::equal_to<Key>,
+	         typename AllocatorType = Allocator<Pair<const Key, Value>>>
+	using Map = NodeMap<Key, Value, HashType, Pred, AllocatorType>;
+#else
+	template<typename Key, typename Value, typename HashType = Hash<Key>, typename Pred = std::equal_to<Key>,
+	         typename AllocatorType = Allocator<Pair<const Key, Value>>>
+	using Map = FlatHashMap<Key, Value, HashType, Pred, AllocatorType>;
+#endif
 
 	template<typename Key, typename Value, typename HashType = Hash<Key>, typename Pred = std::equal_to<Key>,
 	         typename AllocatorType = Allocator<Pair<const Key, Value>>>
@@ -28,7 +42,15 @@ namespace Trinex
 
 	template<typename Key, typename Value, typename HashType = Hash<Key>, typename Pred = std::equal_to<Key>,
 	         typename AllocatorType, typename ArchiveType>
-	inline bool trinex_serialize_map(ArchiveType& ar, Map<Key, Value, HashType, Pred, AllocatorType>& map)
+	inline bool trinex_serialize_map(ArchiveType& ar, NodeMap<Key, Value, HashType, Pred, AllocatorType>& map)
+	    requires(is_complete_archive_type<ArchiveType>)
+	{
+		return ar.serialize_map(map);
+	}
+
+	template<typename Key, typename Value, typename HashType = Hash<Key>, typename Pred = std::equal_to<Key>,
+	         typename AllocatorType, typename ArchiveType>
+	inline bool trinex_serialize_map(ArchiveType& ar, FlatHashMap<Key, Value, HashType, Pred, AllocatorType>& map)
 	    requires(is_complete_archive_type<ArchiveType>)
 	{
 		return ar.serialize_map(map);
@@ -42,8 +64,19 @@ namespace Trinex
 	}
 
 	template<typename Key, typename Value, typename HashType, typename Pred, typename AllocatorType>
-	struct Serializer<Map<Key, Value, HashType, Pred, AllocatorType>> {
-		bool serialize(Archive& ar, Map<Key, Value, HashType, Pred, AllocatorType>& map) { return trinex_serialize_map(ar, map); }
+	struct Serializer<NodeMap<Key, Value, HashType, Pred, AllocatorType>> {
+		bool serialize(Archive& ar, NodeMap<Key, Value, HashType, Pred, AllocatorType>& map)
+		{
+			return trinex_serialize_map(ar, map);
+		}
+	};
+
+	template<typename Key, typename Value, typename HashType, typename Pred, typename AllocatorType>
+	struct Serializer<FlatHashMap<Key, Value, HashType, Pred, AllocatorType>> {
+		bool serialize(Archive& ar, FlatHashMap<Key, Value, HashType, Pred, AllocatorType>& map)
+		{
+			return trinex_serialize_map(ar, map);
+		}
 	};
 
 	template<typename Key, typename Value, typename Compare, typename AllocatorType>
@@ -1,4 +1,5 @@
 #pragma once
+#include <Core/etl/map.hpp>
 #include <Core/etl/vector.hpp>
 #include <Core/types/name.hpp>
 
@@ -11,9 +12,20 @@ namespace Trinex
 	private:
 		using iterator       = Object**;
 		using const_iterator = Object* const*;
-		static bool lower_bound(iterator begin, iterator end, iterator& out, Object* object, Refl::Class* check_class);
-		static Object* find(const_iterator begin, const_iterator end, StringView full_name);
-		static Object* find(const_iterator begin, const_iterator end, Name name);
+
+		// Nodes with a few childs are searched linearly, larger nodes keep a hash index by the name of the child
+		static constexpr usize index_threshold = 32;
+
+		struct ChildIndex {
+			Map<u32, Object*> objects;
+			u32 collisions = 0;// Count of childs which share the name with another indexed child
+		};
+
+		static bool is_element(Object* object, Refl::Class* check_class);
+		static void add(ChildIndex& index, const_iterator begin, const_iterator end, Object* child);
+		static void remove(ChildIndex& index, const_iterator begin, const_iterator end, Object* child);
+		static Object* find(const ChildIndex& index, const_iterator begin, const_iterator end, StringView full_name);
+		static Object* find(const ChildIndex& index, const_iterator begin, const_iterator end, Name name);
 
 
 		template<typename Super, typename Element = Object>
@@ -24,6 +36,7 @@ namespace Trinex
 
 		protected:
 			Container m_childs;
+			ChildIndex m_index;
 
 		public:
 			const Container& childs() const { return m_childs; }
@@ -56,33 +69,31 @@ namespace Trinex
 	class ObjectTreeNode : public ObjectTreeNodeStatics::DataHolder<Super, Element>
 	{
 		using Holder = ObjectTreeNodeStatics::DataHolder<Super, Element>;
+		using It     = ObjectTreeNodeStatics::const_iterator;
+
+		inline It childs_begin() const { return reinterpret_cast<It>(Holder::m_childs.data()); }
+		inline It childs_end() const { return reinterpret_cast<It>(Holder::m_childs.data() + Holder::m_childs.size()); }
 
 	protected:
 		Object* register_child(Object* child, u32& index) override
 		{
-			Object** begin = reinterpret_cast<Object**>(Holder::m_childs.begin());
-			Object** end   = reinterpret_cast<Object**>(Holder::m_childs.end());
-			Object** place = nullptr;
-
-			if (!ObjectTreeNodeStatics::lower_bound(begin, end, place, child, Element::static_reflection()))
+			if (!ObjectTreeNodeStatics::is_element(child, Element::static_reflection()))
 				return Super::register_child(child, index);
 
-			Holder::m_childs.insert(reinterpret_cast<Element**>(place), Super::template instance_cast<Element>(child));
+			index = Holder::m_childs.size();
+			Holder::m_childs.push_back(Super::template instance_cast<Element>(child));
+			ObjectTreeNodeStatics::add(Holder::m_index, childs_begin(), childs_end(), child);
 			return this;
 		}
 
 		bool unregister_child(Object* child) override
 		{
-			Object** begin = reinterpret_cast<Object**>(Holder::m_childs.begin());
-			Object** end   = reinterpret_cast<Object**>(Holder::m_childs.end());
-			Object** place = nullptr;
-
-			if (!ObjectTreeNodeStatics::lower_bound(begin, end, place, child, Element::static_reflection()))
+			if (!ObjectTreeNodeStatics::is_element(child, Element::static_reflection()))
 				return Super::unregister_child(child);
 
-			if (place != end)
+			if (Super::template instance_cast<Element>(child)->remove_from(Holder::m_childs))
 			{
-				Holder::m_childs.erase(reinterpret_cast<Element**>(place));
+				ObjectTreeNodeStatics::remove(Holder::m_index, childs_begin(), childs_end(), child);
 				return true;
 			}
 
@@ -92,11 +103,7 @@ namespace Trinex
 	public:
 		Object* find_child_object(StringView name) const override
 		{
-			using It = ObjectTreeNodeStatics::const_iterator;
-			It begin = reinterpret_cast<It>(Holder::m_childs.begin());
-			It end   = reinterpret_cast<It>(Holder::m_childs.end());
-
-			if (auto result = ObjectTreeNodeStatics::find(begin, end, name))
+			if (auto result = ObjectTreeNodeStatics::find(Holder::m_index, childs_begin(), childs_end(), name))
 				return result;
 
 			return Super::find_child_object(name);
@@ -104,11 +111,7 @@ namespace Trinex
 
 		Object* find_child_object(Name name) const
 		{
-			using It = ObjectTreeNodeStatics::const_iterator;
-			It begin = reinterpret_cast<It>(Holder::m_childs.begin());
-			It end   = reinterpret_cast<It>(Holder::m_childs.end());
-
-			if (auto result = ObjectTreeNodeStatics::find(begin, end, name))
+			if (auto result = ObjectTreeNodeStatics::find(Holder::m_index, childs_begin(), childs_end(), name))
 				return result;
 
 			return Super::find_child_object(name.to_string());
@@ -1,6 +1,7 @@
 #pragma once
 #include <Core/etl/allocator.hpp>
 #include <Core/etl/archive_predef.hpp>
+#include <Core/etl/flat_hash_set.hpp>
 #include <Core/etl/hash.hpp>
 #include <set>
 #include <unordered_set>
@@ -9,9 +10,20 @@ namespace Trinex
 {
 	class Archive;
 
+	// Node based hash set, addresses of the elements are stable until erasure
 	template<typename Type, typename HashType = Hash<Type>, typename Pred = std::equal_to<Type>,
 	         typename AllocatorType = Allocator<Type>>
-	using Set = std::unordered_set<Type, HashType, Pred, AllocatorType>;
+	using NodeSet = std::unordered_set<Type, HashType, Pred, AllocatorType>;
+
+#if TRINEX_WITH_STD_HASH_MAP
+	template<typename Type, typename HashType = Hash<Type>, typename Pred = std::equal_to<Type>,
+	         typename AllocatorType = Allocator<Type>>
+	using Set = NodeSet<Type, HashType, Pred, AllocatorType>;
+#else
+	template<typename Type, typename HashType = Hash<Type>, typename Pred = std::equal_to<Type>,
+	         typename AllocatorType = Allocator<Type>>
+	using Set = FlatHashSet<Type, HashType, Pred, AllocatorType>;
+#endif
 
 	template<typename Type, typename HashType = Hash<Type>, typename Pred = std::equal_to<Type>,
 	         typename AllocatorType = Allocator<Type>>
@@ -25,7 +37,15 @@ namespace Trinex
 
 	template<typename Type, typename HashType = Hash<Type>, typename Pred = std::equal_to<Type>,
 	         typename AllocatorType = Allocator<Type>, typename ArchiveType>
-	inline bool trinex_serialize_set(ArchiveType& ar, Set<Type, HashType, Pred, AllocatorType>& set)
+	inline bool trinex_serialize_set(ArchiveType& ar, NodeSet<Type, HashType, Pred, AllocatorType>& set)
+	    requires(is_complete_archive_type<ArchiveType>)
+	{
+		return ar.process_set(set);
+	}
+
+	template<typename Type, typename HashType = Hash<Type>, typename Pred = std::equal_to<Type>,
+	         typename AllocatorType = Allocator<Type>, typename ArchiveType>
+	inline bool trinex_serialize_set(ArchiveType& ar, FlatHashSet<Type, HashType, Pred, AllocatorType>& set)
 	    requires(is_complete_archive_type<ArchiveType>)
 	{
 		return ar.process_set(set);
@@ -39,8 +59,13 @@ namespace Trinex
 	}
 
 	template<typename Type, typename HashType, typename Pred, typename AllocatorType>
-	struct Serializer<Set<Type, HashType, Pred, AllocatorType>> {
-		bool serialize(Archive& ar, Set<Type, HashType, Pred, AllocatorType>& set) { return trinex_serialize_set(set); }
+	struct Serializer<NodeSet<Type, HashType, Pred, AllocatorType>> {
+		bool serialize(Archive& ar, NodeSet<Type, HashType, Pred, AllocatorType>& set) { return trinex_serialize_set(set); }
+	};
+
+	template<typename Type, typename HashType, typename Pred, typename AllocatorType>
+	struct Serializer<FlatHashSet<Type, HashType, Pred, AllocatorType>> {
+		bool serialize(Archive& ar, FlatHashSet<Type, HashType, Pred, AllocatorType>& set) { return trinex_serialize_set(set); }
 	};
 
 	template<typename Type, typename Compare, typename AllocatorType>
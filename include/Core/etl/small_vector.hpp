@@ -0,0 +1,583 @@
+#pragma once
+#include <Core/etl/allocator.hpp>
+#include <Core/etl/archive_predef.hpp>
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <memory>
+
+namespace Trinex
+{
+	// Vector which stores up to InlineCapacity elements inside of the object and allocates memory only when it grows beyond that.
+	// Interface matches Vector. Unlike Vector, moving a SmallVector with inline elements moves the elements themselves, so
+	// iterators and pointers into the source are not preserved by move construction, move assignment and swap
+	template<typename T, usize InlineCapacity, typename AllocatorType = Allocator<T>>
+	class SmallVector : private AllocatorType
+	{
+		static_assert(InlineCapacity > 0, "Use Vector for containers without inline storage");
+
+	public:
+		using value_type             = T;
+		using reference              = T&;
+		using const_reference        = const T&;
+		using pointer                = T*;
+		using const_pointer          = const T*;
+		using iterator               = T*;
+		using const_iterator         = const T*;
+		using reverse_iterator       = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+		using size_type       = std::size_t;
+		using difference_type = std::ptrdiff_t;
+
+		static constexpr size_type inline_capacity = InlineCapacity;
+
+	private:
+		pointer m_start;
+		pointer m_finish;
+		pointer m_end;
+		alignas(T) u8 m_inline[sizeof(T) * InlineCapacity];
+
+		template<typename IteratorType>
+		using IteratorCategory = typename std::iterator_traits<IteratorType>::iterator_category;
+
+		template<typename IteratorType>
+		using RequireInputIter =
+		        std::enable_if_t<std::is_convertible<IteratorCategory<IteratorType>, std::input_iterator_tag>::value>;
+
+		template<typename IteratorType>
+		static constexpr inline bool is_forward_iterator =
+		        std::is_convertible_v<typename std::iterator_traits<IteratorType>::iterator_category, std::forward_iterator_tag>;
+
+	public:
+		constexpr AllocatorType& allocator() { return *this; }
+		constexpr const AllocatorType& allocator() const { return *this; }
+
+	private:
+		inline pointer inline_storage() { return reinterpret_cast<pointer>(m_inline); }
+		inline const_pointer inline_storage() const { return reinterpret_cast<const_pointer>(m_inline); }
+
+		inline void reset_to_inline()
+		{
+			m_start  = inline_storage();
+			m_finish = m_start;
+			m_end    = m_start + InlineCapacity;
+		}
+
+		inline void release_storage()
+		{
+			if (!is_inline())
+				allocator().deallocate(m_start, capacity());
+		}
+
+		constexpr size_type next_capacity(size_type n = 1) const
+		{
+			size_type c = capacity();
+			while (c < size() + n) c *= 2;
+			return c;
+		}
+
+		// Moves elements to a new heap buffer with a gap of gap_size uninitialized elements at index gap.
+		// Constructor of the gap elements must be called by the caller before the next container operation
+		void reallocate(size_type new_capacity, size_type gap = 0, size_type gap_size = 0)
+		{
+			const size_type count = size();
+			pointer new_start     = allocator().allocate(new_capacity);
+
+			std::uninitialized_move(m_start, m_start + gap, new_start);
+			std::uninitialized_move(m_start + gap, m_finish, new_start + gap + gap_size);
+			std::destroy(m_start, m_finish);
+			release_storage();
+
+			m_start  = new_start;
+			m_finish = new_start + count + gap_size;
+			m_end    = new_start + new_capacity;
+		}
+
+		template<typename... Args>
+		void realloc_insert(size_type index, Args&&... args)
+		{
+			// New element is constructed before the old buffer is released, because arguments can refer to an element of this vector
+			const size_type new_capacity = next_capacity(1);
+			pointer new_start            = allocator().allocate(new_capacity);
+
+			::new (static_cast<void*>(new_start + index)) value_type(std::forward<Args>(args)...);
+
+			std::uninitialized_move(m_start, m_start + index, new_start);
+			std::uninitialized_move(m_start + index, m_finish, new_start + index + 1);
+			std::destroy(m_start, m_finish);
+
+			const size_type count = size();
+			release_storage();
+
+			m_start  = new_start;
+			m_finish = new_start + count + 1;
+			m_end    = new_start + new_capacity;
+		}
+
+		// Opens a gap of n elements at index by moving the tail to the right, returns count of gap elements which
+		// still contain moved-from live objects, the rest of the gap is uninitialized
+		size_type open_gap(size_type index, size_type n)
+		{
+			const size_type elems_after = size() - index;
+			pointer pos                 = m_start + index;
+			pointer old_finish          = m_finish;
+
+			if (elems_after > n)
+			{
+				std::uninitialized_move(old_finish - n, old_finish, old_finish);
+				std::move_backward(pos, old_finish - n, old_finish);
+				m_finish += n;
+				return n;
+			}
+
+			std::uninitialized_move(pos, old_finish, pos + n);
+			m_finish += n;
+			return elems_after;
+		}
+
+		template<typename ForwardIterator>
+		void range_insert(size_type index, ForwardIterator first, ForwardIterator last, size_type n)
+		{
+			if (n == 0)
+				return;
+
+			if (size_type(m_end - m_finish) < n)
+			{
+				reallocate(next_capacity(n), index, n);
+				std::uninitialized_copy(first, last, m_start + index);
+				return;
+			}
+
+			const size_type live = open_gap(index, n);
+			ForwardIterator mid  = first;
+			std::advance(mid, live);
+			std::copy(first, mid, m_start + index);
+			std::uninitialized_copy(mid, last, m_start + index + live);
+		}
+
+		void fill_insert(size_type index, size_type n, const value_type& value)
+		{
+			if (n == 0)
+				return;
+
+			value_type copy = value;
+
+			if (size_type(m_end - m_finish) < n)
+			{
+				reallocate(next_capacity(n), index, n);
+				std::uninitialized_fill_n(m_start + index, n, copy);
+				return;
+			}
+
+			const size_type live = open_gap(index, n);
+			std::fill_n(m_start + index, live, copy);
+			std::uninitialized_fill_n(m_start + index + live, n - live, copy);
+		}
+
+		void erase_at_end(iterator pos)
+		{
+			std::destroy(pos, m_finish);
+			m_finish = pos;
+		}
+
+		void move_from(SmallVector&& other)
+		{
+			if (other.is_inline())
+			{
+				reset_to_inline();
+				m_finish = std::uninitialized_move(other.m_start, other.m_finish, m_start);
+				other.clear();
+			}
+			else
+			{
+				m_start  = other.m_start;
+				m_finish = other.m_finish;
+				m_end    = other.m_end;
+				other.reset_to_inline();
+			}
+		}
+
+	public:
+		constexpr inline iterator begin() { return m_start; }
+
+		constexpr inline const_iterator begin() const { return m_start; }
+
+		constexpr inline iterator end() { return m_finish; }
+
+		constexpr inline const_iterator end() const { return m_finish; }
+
+		constexpr inline const_iterator cbegin() const { return m_start; }
+
+		constexpr inline const_iterator cend() const { return m_finish; }
+
+		constexpr inline reverse_iterator rbegin() { return reverse_iterator(end()); }
+
+		constexpr inline const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+
+		constexpr inline reverse_iterator rend() { return reverse_iterator(begin()); }
+
+		constexpr inline const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+		constexpr inline const_reverse_iterator crbegin() const { return const_reverse_iterator(end()); }
+
+		constexpr inline const_reverse_iterator crend() const { return const_reverse_iterator(begin()); }
+
+		SmallVector() noexcept { reset_to_inline(); }
+
+		SmallVector(const AllocatorType& allocator) noexcept : AllocatorType(allocator) { reset_to_inline(); }
+
+		explicit SmallVector(size_type n) : SmallVector() { resize(n); }
+
+		SmallVector(size_type n, const value_type& v) : SmallVector() { assign(n, v); }
+
+		template<class InputIterator, typename = RequireInputIter<InputIterator>>
+		SmallVector(InputIterator first, InputIterator last) : SmallVector()
+		{
+			assign(first, last);
+		}
+
+		SmallVector(std::initializer_list<T> list) : SmallVector(list.begin(), list.end()) {}
+
+		SmallVector(const SmallVector& other) : SmallVector(other.allocator())
+		{
+			assign(other.begin(), other.end());
+		}
+
+		SmallVector(SmallVector&& other) : AllocatorType(std::move(other.allocator())) { move_from(std::move(other)); }
+
+		~SmallVector()
+		{
+			clear();
+			release_storage();
+		}
+
+		SmallVector& operator=(const SmallVector& other)
+		{
+			if (&other != this)
+			{
+				assign(other.begin(), other.end());
+			}
+			return *this;
+		}
+
+		SmallVector& operator=(SmallVector&& other)
+		{
+			if (&other != this)
+			{
+				clear();
+
+				if (other.is_inline())
+				{
+					// Keep own buffer, it can hold all inline elements of other
+					m_finish = std::uninitialized_move(other.m_start, other.m_finish, m_start);
+					other.clear();
+				}
+				else
+				{
+					release_storage();
+					move_from(std::move(other));
+				}
+			}
+			return *this;
+		}
+
+		SmallVector& operator=(std::initializer_list<T> list)
+		{
+			assign(list.begin(), list.end());
+			return *this;
+		}
+
+		constexpr reference operator[](size_type n) { return *(m_start + n); }
+
+		constexpr const_reference operator[](size_type n) const { return *(m_start + n); }
+
+		constexpr reference at(size_type n) { return (*this)[n]; }
+
+		constexpr const_reference at(size_type n) const { return (*this)[n]; }
+
+		constexpr reference front() { return *begin(); }
+
+		constexpr const_reference front() const { return *begin(); }
+
+		constexpr reference back() { return *(end() - 1); }
+
+		constexpr const_reference back() const { return *(end() - 1); }
+
+		constexpr pointer data() noexcept { return m_start; }
+
+		constexpr const_pointer data() const noexcept { return m_start; }
+
+		constexpr inline bool empty() const { return m_start == m_finish; }
+
+		constexpr inline size_type size() const { return m_finish - m_start; }
+
+		constexpr inline size_type max_size() const
+		{
+			const size_type diffmax  = std::numeric_limits<difference_type>::max() / sizeof(value_type);
+			const size_type allocmax = std::allocator_traits<AllocatorType>::max_size(allocator());
+			return (std::min) (diffmax, allocmax);
+		}
+
+		constexpr inline size_type capacity() const { return m_end - m_start; }
+
+		// Returns true while elements are stored inside of the object
+		inline bool is_inline() const { return m_start == inline_storage(); }
+
+		inline void clear() { erase_at_end(m_start); }
+
+		void reserve(size_type n)
+		{
+			if (n > capacity())
+				reallocate(n);
+		}
+
+		void resize(size_type n)
+		{
+			if (n > size())
+			{
+				reserve(n);
+				m_finish = std::uninitialized_value_construct_n(m_finish, n - size());
+			}
+			else if (n < size())
+			{
+				erase_at_end(m_start + n);
+			}
+		}
+
+		void resize(size_type n, const value_type& v)
+		{
+			if (n > size())
+			{
+				fill_insert(size(), n - size(), v);
+			}
+			else if (n < size())
+			{
+				erase_at_end(m_start + n);
+			}
+		}
+
+		void assign(size_type n, const value_type& value)
+		{
+			value_type copy = value;
+			clear();
+			reserve(n);
+			m_finish = std::uninitialized_fill_n(m_start, n, copy);
+		}
+
+		template<class InputIterator, typename = RequireInputIter<InputIterator>>
+		void assign(InputIterator first, InputIterator last)
+		{
+			clear();
+
+			if constexpr (is_forward_iterator<InputIterator>)
+			{
+				reserve(std::distance(first, last));
+				m_finish = std::uninitialized_copy(first, last, m_start);
+			}
+			else
+			{
+				for (; first != last; ++first) emplace_back(*first);
+			}
+		}
+
+		void assign(std::initializer_list<T> list) { assign(list.begin(), list.end()); }
+
+		template<class... Args>
+		iterator emplace(const_iterator pos, Args&&... args)
+		{
+			const size_type index = pos - cbegin();
+
+			if (pos == cend())
+			{
+				emplace_back(std::forward<Args>(args)...);
+			}
+			else if (m_finish == m_end)
+			{
+				realloc_insert(index, std::forward<Args>(args)...);
+			}
+			else
+			{
+				value_type tmp(std::forward<Args>(args)...);
+				::new (static_cast<void*>(m_finish)) value_type(std::move(*(m_finish - 1)));
+				++m_finish;
+				std::move_backward(m_start + index, m_finish - 2, m_finish - 1);
+				m_start[index] = std::move(tmp);
+			}
+
+			return m_start + index;
+		}
+
+		iterator insert(const_iterator pos, const value_type& v) { return emplace(pos, v); }
+
+		iterator insert(const_iterator pos, value_type&& v) { return emplace(pos, std::move(v)); }
+
+		iterator insert(const_iterator pos, size_type n, const value_type& v)
+		{
+			const size_type index = pos - cbegin();
+			fill_insert(index, n, v);
+			return m_start + index;
+		}
+
+		template<class InputIterator, typename = RequireInputIter<InputIterator>>
+		iterator insert(const_iterator pos, InputIterator first, InputIterator last)
+		{
+			const size_type index = pos - cbegin();
+
+			if constexpr (is_forward_iterator<InputIterator>)
+			{
+				range_insert(index, first, last, std::distance(first, last));
+			}
+			else
+			{
+				const size_type old_size = size();
+				for (; first != last; ++first) emplace_back(*first);
+				std::rotate(m_start + index, m_start + old_size, m_finish);
+			}
+
+			return m_start + index;
+		}
+
+		iterator insert(const_iterator pos, const std::initializer_list<value_type>& v) { return insert(pos, v.begin(), v.end()); }
+
+		template<typename... Args>
+		reference emplace_back(Args&&... args)
+		{
+			if (m_finish != m_end)
+			{
+				::new (static_cast<void*>(m_finish)) value_type(std::forward<Args>(args)...);
+				++m_finish;
+			}
+			else
+			{
+				realloc_insert(size(), std::forward<Args>(args)...);
+			}
+			return back();
+		}
+
+		reference push_back(value_type&& v) { return emplace_back(std::move(v)); }
+
+		reference push_back(const value_type& v) { return emplace_back(v); }
+
+		void pop_back()
+		{
+			if (!empty())
+			{
+				--m_finish;
+				std::destroy_at(m_finish);
+			}
+		}
+
+		iterator erase(const_iterator pos)
+		{
+			iterator non_const_pos = const_cast<iterator>(pos);
+
+			if (empty())
+				return non_const_pos;
+
+			std::move(non_const_pos + 1, end(), non_const_pos);
+			pop_back();
+			return non_const_pos;
+		}
+
+		iterator erase(const_iterator first, const_iterator last)
+		{
+			iterator non_const_first = const_cast<iterator>(first);
+			iterator non_const_last  = const_cast<iterator>(last);
+
+			if (first != last)
+			{
+				erase_at_end(std::move(non_const_last, end(), non_const_first));
+			}
+			return non_const_first;
+		}
+
+		iterator erase_unordered(const_iterator pos)
+		{
+			iterator non_const_pos = const_cast<iterator>(pos);
+
+			if (empty())
+				return non_const_pos;
+
+			iterator last = end() - 1;
+
+			if (non_const_pos != last)
+				*non_const_pos = std::move(*last);
+
+			pop_back();
+			return non_const_pos;
+		}
+
+		iterator erase_unordered(const_iterator first, const_iterator last)
+		{
+			iterator non_const_first = const_cast<iterator>(first);
+			iterator non_const_last  = const_cast<iterator>(last);
+
+			if (first != last)
+			{
+				const size_type count      = non_const_last - non_const_first;
+				const size_type tail_count = end() - non_const_last;
+				const size_type move_count = std::min(count, tail_count);
+
+				if (move_count > 0)
+					std::move(end() - move_count, end(), non_const_first);
+
+				erase_at_end(end() - count);
+			}
+			return non_const_first;
+		}
+
+		// Moves elements back to the inline storage when they fit, otherwise to a heap buffer of exact size
+		void shrink_to_fit()
+		{
+			if (is_inline() || capacity() == size())
+				return;
+
+			if (size() <= InlineCapacity)
+			{
+				pointer old_start     = m_start;
+				pointer old_finish    = m_finish;
+				const size_type count = size();
+
+				std::uninitialized_move(old_start, old_finish, inline_storage());
+				std::destroy(old_start, old_finish);
+				release_storage();
+
+				reset_to_inline();
+				m_finish = m_start + count;
+			}
+			else
+			{
+				reallocate(size());
+			}
+		}
+
+		void swap(SmallVector& other)
+		{
+			if (!is_inline() && !other.is_inline())
+			{
+				std::swap(m_start, other.m_start);
+				std::swap(m_finish, other.m_finish);
+				std::swap(m_end, other.m_end);
+			}
+			else
+			{
+				SmallVector tmp(std::move(other));
+				other = std::move(*this);
+				*this = std::move(tmp);
+			}
+		}
+	};
+
+	template<typename Type, usize N, typename AllocatorType, typename ArchiveType>
+	inline bool trinex_serialize_small_vector(ArchiveType& ar, SmallVector<Type, N, AllocatorType>& vector)
+	    requires(is_complete_archive_type<ArchiveType>)
+	{
+		return ar.serialize_vector(vector);
+	}
+
+	template<typename Type, usize N, typename Alloc>
+	struct Serializer<SmallVector<Type, N, Alloc>> {
+		bool serialize(Archive& ar, SmallVector<Type, N, Alloc>& vector) { return trinex_serialize_small_vector(ar, vector); }
+	};
+}// namespace Trinex
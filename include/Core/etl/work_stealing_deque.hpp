@@ -0,0 +1,147 @@
+#pragma once
+#include <Core/engine_types.hpp>
+#include <Core/etl/atomic.hpp>
+#include <Core/etl/vector.hpp>
+#include <Core/trx_new.hpp>
+
+namespace Trinex
+{
+	// Chase-Lev work-stealing deque.
+	// The owner thread pushes and pops at the bottom, any other thread may steal from the top.
+	// Retired buffers are kept alive until destruction, because a concurrent thief may still read them.
+	template<typename Type>
+	class WorkStealingDeque final
+	{
+		static_assert(std::is_trivially_copyable_v<Type>, "WorkStealingDeque supports only trivially copyable types");
+
+	private:
+		struct Buffer {
+			i64 capacity;
+			i64 mask;
+			Atomic<Type>* items;
+
+			Buffer(i64 size) : capacity(size), mask(size - 1)
+			{
+				items = reinterpret_cast<Atomic<Type>*>(ByteAllocator::allocate_aligned(sizeof(Atomic<Type>) * size, 64));
+
+				for (i64 i = 0; i < size; ++i) new (items + i) Atomic<Type>();
+			}
+
+			~Buffer() { ByteAllocator::deallocate(reinterpret_cast<u8*>(items)); }
+
+			inline Type load(i64 index) const { return items[index & mask].load(etl::memory_order_relaxed); }
+			inline void store(i64 index, Type value) { items[index & mask].store(value, etl::memory_order_relaxed); }
+
+			Buffer* grow(i64 bottom, i64 top) const
+			{
+				Buffer* buffer = trx_new Buffer(capacity * 2);
+
+				for (i64 i = top; i != bottom; ++i)
+				{
+					buffer->store(i, load(i));
+				}
+
+				return buffer;
+			}
+		};
+
+		alignas(64) Atomic<i64> m_top        = 0;
+		alignas(64) Atomic<i64> m_bottom     = 0;
+		alignas(64) Atomic<Buffer*> m_buffer = nullptr;
+		Vector<Buffer*> m_retired;
+
+	public:
+		explicit WorkStealingDeque(i64 capacity = 256)
+		{
+			i64 size = 1;
+			while (size < capacity) size <<= 1;
+			m_buffer.store(trx_new Buffer(size), etl::memory_order_relaxed);
+		}
+
+		WorkStealingDeque(const WorkStealingDeque&)            = delete;
+		WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+		// Owner thread only
+		void push(Type value)
+		{
+			i64 bottom     = m_bottom.load(etl::memory_order_relaxed);
+			i64 top        = m_top.load(etl::memory_order_acquire);
+			Buffer* buffer = m_buffer.load(etl::memory_order_relaxed);
+
+			if (bottom - top > buffer->capacity - 1)
+			{
+				m_retired.push_back(buffer);
+				buffer = buffer->grow(bottom, top);
+				m_buffer.store(buffer, etl::memory_order_release);
+			}
+
+			buffer->store(bottom, value);
+			std::atomic_thread_fence(etl::memory_order_release);
+			m_bottom.store(bottom + 1, etl::memory_order_relaxed);
+		}
+
+		// Owner thread only
+		bool pop(Type& out)
+		{
+			i64 bottom     = m_bottom.load(etl::memory_order_relaxed) - 1;
+			Buffer* buffer = m_buffer.load(etl::memory_order_relaxed);
+			m_bottom.store(bottom, etl::memory_order_relaxed);
+			std::atomic_thread_fence(etl::memory_order_seq_cst);
+			i64 top = m_top.load(etl::memory_order_relaxed);
+
+			if (top <= bottom)
+			{
+				out = buffer->load(bottom);
+
+				if (top == bottom)
+				{
+					bool success = m_top.compare_exchange_strong(top, top + 1, etl::memory_order_seq_cst, etl::memory_order_relaxed);
+					m_bottom.store(bottom + 1, etl::memory_order_relaxed);
+					return success;
+				}
+
+				return true;
+			}
+
+			m_bottom.store(bottom + 1, etl::memory_order_relaxed);
+			return false;
+		}
+
+		// Any thread
+		bool steal(Type& out)
+		{
+			i64 top = m_top.load(etl::memory_order_acquire);
+			std::atomic_thread_fence(etl::memory_order_seq_cst);
+			i64 bottom = m_bottom.load(etl::memory_order_acquire);
+
+			if (top < bottom)
+			{
+				Buffer* buffer = m_buffer.load(etl::memory_order_acquire);
+				Type value     = buffer->load(top);
+
+				if (!m_top.compare_exchange_strong(top, top + 1, etl::memory_order_seq_cst, etl::memory_order_relaxed))
+					return false;
+
+				out = value;
+				return true;
+			}
+
+			return false;
+		}
+
+		inline usize size() const
+		{
+			i64 bottom = m_bottom.load(etl::memory_order_relaxed);
+			i64 top    = m_top.load(etl::memory_order_relaxed);
+			return bottom > top ? static_cast<usize>(bottom - top) : 0;
+		}
+
+		inline bool empty() const { return size() == 0; }
+
+		~WorkStealingDeque()
+		{
+			for (Buffer* buffer : m_retired) trx_delete buffer;
+			trx_delete m_buffer.load(etl::memory_order_relaxed);
+		}
+	};
+}// namespace Trinex
@@ -19,5 +19,7 @@ namespace Trinex
 
 		static const FileFlag& package_flag();
 		static const FileFlag& asset_flag();
+		static const FileFlag& asset_imports_flag();// Asset with the import table stored before the data
+		static const FileFlag& asset_schemas_flag();// Asset with the import and schema tables stored before the data
 	};
 }// namespace Trinex
@@ -66,4 +66,39 @@ namespace Trinex
 
 		~FileReader();
 	};
+
+	// Reads a native file through a read-only memory mapping. The pages are read ahead by the OS while the file is read
+	// sequentially and read_view returns pointers into the mapping, so no data is copied into intermediate buffers.
+	// Files of non-native file systems can't be mapped, FileReader must be used for them
+	class ENGINE_EXPORT MappedFileReader : public BufferReader
+	{
+	public:
+		using Pointer = MappedFileReader*;
+
+	private:
+		const u8* m_data   = nullptr;
+		usize m_size       = 0;
+		ReadPos m_position = 0;
+
+	public:
+		MappedFileReader();
+		MappedFileReader(const Path& path);
+		MappedFileReader(MappedFileReader&&);
+		MappedFileReader& operator=(MappedFileReader&&);
+
+		bool open(const Path& path);
+		MappedFileReader& close();
+
+		bool read(u8* data, usize size) override;
+		const u8* read_view(usize size) override;
+		ReadPos position() override;
+		MappedFileReader& offset(PosOffset offset, BufferSeekDir dir = BufferSeekDir::Current) override;
+		bool is_open() const override;
+
+		using BufferReader::position;
+		inline const u8* data() const { return m_data; }
+		inline usize size() const { return m_size; }
+
+		~MappedFileReader();
+	};
 }// namespace Trinex
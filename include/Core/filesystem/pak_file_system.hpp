@@ -0,0 +1,91 @@
+#pragma once
+#include <Core/etl/map.hpp>
+#include <Core/etl/vector.hpp>
+#include <Core/filesystem/filesystem.hpp>
+
+namespace Trinex::VFS
+{
+	// Read-only file system over a cooked package archive. The archive is mapped into memory when the file system is mounted
+	// and the table of contents is used directly from the mapping, so opening a file doesn't touch the native file system.
+	//
+	// Archive layout: Header | data of the entries | Entry[entries_count] sorted by path hash | paths
+	// All values are little endian, paths are relative to the cooked directory and use '/' as separator
+	class ENGINE_EXPORT PakFileSystem : public FileSystem
+	{
+	public:
+		static constexpr u32 magic            = 0x4B415054;// TPAK
+		static constexpr u32 version          = 1;
+		static constexpr usize data_alignment = 16;
+
+		enum Compression : u32
+		{
+			None = 0,
+			LZ4  = 1,
+		};
+
+		struct Header {
+			u32 magic;
+			u32 version;
+			u64 entries_offset;
+			u64 entries_count;
+			u64 paths_offset;
+			u64 paths_size;
+		};
+
+		struct Entry {
+			u64 hash;
+			u64 offset;
+			u64 size;    // Size of the stored data
+			u64 raw_size;// Size of the file after decompression
+			u32 path_offset;
+			u32 path_size;
+			u32 compression;
+			u32 reserved;
+		};
+
+	private:
+		Path m_archive;
+		const u8* m_data       = nullptr;
+		usize m_size           = 0;
+		const Entry* m_entries = nullptr;
+		usize m_entries_count  = 0;
+		const char* m_paths    = nullptr;
+
+		// Children of every directory, the root directory has empty name
+		Map<String, Vector<String>> m_directories;
+
+		void collect_recursive(const String& directory, Vector<Path>& paths) const;
+
+	protected:
+		DirectoryIteratorInterface* create_directory_iterator(const Path& path) override;
+		DirectoryIteratorInterface* create_recursive_directory_iterator(const Path& path) override;
+
+	public:
+		PakFileSystem(const Path& mount_point, const Path& archive);
+		~PakFileSystem();
+
+		// Packs all files of the directory into the archive, both paths are resolved by the root file system
+		static bool cook(const Path& directory, const Path& archive);
+
+		bool is_valid() const;
+		const Entry* find(StringView path) const;
+		StringView path_of(const Entry* entry) const;
+		const u8* data_of(const Entry* entry) const;
+		inline const Entry* entries() const { return m_entries; }
+		inline usize entries_count() const { return m_entries_count; }
+
+		const Path& path() const override;
+		bool is_read_only() const override;
+		File* open(const Path& path, FileOpenMode mode) override;
+		PakFileSystem& close(File* file) override;
+		bool create_dir(const Path& path) override;
+		bool remove(const Path& path) override;
+		bool copy(const Path& src, const Path& dest) override;
+		bool rename(const Path& src, const Path& dest) override;
+		bool is_exist(const Path& path) const override;
+		bool is_file(const Path& file) const override;
+		bool is_dir(const Path& dir) const override;
+		Type type() const override;
+		Path native_path(const Path& path) const override;
+	};
+}// namespace Trinex::VFS
@@ -11,25 +11,54 @@ namespace Trinex
 		class Class;
 	};
 
+	// Incremental tri-color mark and sweep collector.
+	// Roots are objects which are stand alone, referenced by Pointer, owned by another object or not available for GC.
+	// Marking follows the owner of every object and the object references of reflected properties.
+	//
+	// Large gray sets are marked on the TaskGraph workers (at most Settings::gc_mark_threads threads if it isn't zero),
+	// roots, unreachable checks and destruction are processed on the calling thread.
+	// Each update runs the collector for Settings::gc_time_budget milliseconds, a zero budget disables collection.
+	// Objects referenced only by raw or unreflected pointers are destroyed, such holders must use Pointer or StandAlone.
+	// Objects created while marking are scanned before the sweep, storing a reference into an already scanned object must
+	// shade the stored object with write_barrier.
+	// Reflected property setters, Pointer, ownership changes, object lookups and deserialization do it automatically,
+	// native code assigning a raw reflected field or adding the StandAlone flag during a cycle must call it explicitly
 	class ENGINE_EXPORT GarbageCollector final
 	{
 	public:
+		struct Statistics {
+			usize cycles          = 0;
+			usize marked_objects  = 0;// Count of objects marked during the last finished cycle
+			usize destroyed       = 0;// Count of objects destroyed during the last finished cycle
+			f64 cycle_time        = 0.0;// Time spent in the last finished cycle in milliseconds
+			usize total_destroyed = 0;
+		};
+
 		ENGINE_EXPORT static CallBacks<void(Object*)> on_unreachable_check;
 
 		ENGINE_EXPORT static void destroy(Object* object);
 		ENGINE_EXPORT static void update(float dt);
 
+		// Shades the object if the collector is marking, must be called after storing a reference into a scanned object
+		ENGINE_EXPORT static void write_barrier(const Object* object);
+
+		// Finishes the current cycle and runs one more cycle without time limits
+		ENGINE_EXPORT static void collect();
+		ENGINE_EXPORT static bool is_collecting();
+
+		// Returns true if the object was reached by the running cycle, or by the last finished cycle if the collector is idle
+		ENGINE_EXPORT static bool is_marked(const Object* object);
+		ENGINE_EXPORT static Statistics statistics();
+
 		friend class EngineLoop;
 		friend class Class;
 		friend class Refl::Class;
+		friend class Object;
 
 	private:
-		ENGINE_EXPORT static void submit_current_stage();
-		ENGINE_EXPORT static bool process_objects(void (*callback)(Object* object));
-		ENGINE_EXPORT static void mark_unreachable(float dt);
-		ENGINE_EXPORT static void collect_garbage(float dt);
-		ENGINE_EXPORT static void destroy_garbage(float dt);
+		struct Collector;
 
+		ENGINE_EXPORT static void on_object_created(Object* object);
 		ENGINE_EXPORT static void destroy_all_objects();
 	};
 }// namespace Trinex
@@ -10,8 +10,9 @@ namespace Trinex
 	{
 	private:
 		static Localization* s_instance;
-		Map<u64, String> m_translation_map;
-		mutable Map<u64, String> m_default_translation_map;
+		// localize() returns references to the elements, which must survive insertion of new lines
+		NodeMap<u64, String> m_translation_map;
+		mutable NodeMap<u64, String> m_default_translation_map;
 
 	public:
 		CallBacks<void()> on_language_changed;
@@ -8,7 +8,13 @@ namespace Trinex
 	                                    usize src_stride = 0);
 	ENGINE_EXPORT void* memcpy_transform(void* dst, const void* src, usize element_count, usize dst_stride, usize src_stride,
 	                                     void (*transform)(void* dst, const void* src));
+	// Stable hash, use it for values which are stored on disk
 	ENGINE_EXPORT u128 memory_hash(const void* memory, const usize size, u128 seed = 0);
+
+	// Faster hash for runtime keys. Result is the same on all platforms and instruction sets,
+	// but it can change between engine versions, so it must not be stored without memory_hash_fast_version
+	static constexpr u32 memory_hash_fast_version = 1;
+	ENGINE_EXPORT u128 memory_hash_fast(const void* memory, usize size, u128 seed = 0);
 	ENGINE_EXPORT const u8* memory_search(const u8* haystack, usize haystack_len, const u8* needle, usize needle_len);
 
 	FORCE_INLINE constexpr usize align_memory(usize size, usize alignment)
@@ -0,0 +1,100 @@
+#pragma once
+#include <Core/engine_types.hpp>
+
+namespace Trinex
+{
+	enum class MemoryTag : u8
+	{
+		Core,
+		Task,
+		RHI,
+		Render,
+		Script,
+		Editor,
+		Asset,
+		Count,
+	};
+
+	// Per-subsystem memory statistics. Allocations are attributed to the tag of the innermost TagScope of the calling thread.
+	// Allocation counters are always collected. Live and peak bytes are available only in builds with
+	// TRINEX_WITH_MEMORY_TRACKING, because ByteAllocator has to store the tag and size of every allocation
+	class ENGINE_EXPORT MemoryTracker final
+	{
+	public:
+		struct Stats {
+			usize allocations       = 0;// ByteAllocator allocations
+			usize allocated_bytes   = 0;// ByteAllocator allocated bytes
+			usize temp_allocations  = 0;// StackByteAllocator and FrameByteAllocator allocations
+			usize temp_bytes        = 0;// StackByteAllocator and FrameByteAllocator allocated bytes
+			usize frame_allocations = 0;// ByteAllocator allocations during the last frame
+			usize frame_bytes       = 0;// ByteAllocator allocated bytes during the last frame
+			usize live_bytes        = 0;
+			usize peak_bytes        = 0;
+		};
+
+		class ENGINE_EXPORT TagScope final
+		{
+		private:
+			MemoryTag m_prev;
+
+		public:
+			TagScope(MemoryTag tag);
+			TagScope(const TagScope&)            = delete;
+			TagScope& operator=(const TagScope&) = delete;
+			~TagScope();
+		};
+
+		// Counts ByteAllocator allocations made by the current thread since construction
+		class ENGINE_EXPORT AllocationScope
+		{
+		private:
+			u64 m_start;
+
+		public:
+			AllocationScope();
+			AllocationScope(const AllocationScope&)            = delete;
+			AllocationScope& operator=(const AllocationScope&) = delete;
+			usize allocations() const;
+		};
+
+		// Test hook: reports a failure if the scope performed other number of allocations than expected
+		class ENGINE_EXPORT ExpectAllocations final : public AllocationScope
+		{
+		private:
+			usize m_expected;
+			const char* m_file;
+			int m_line;
+
+		public:
+			ExpectAllocations(usize expected, const char* file, int line);
+			~ExpectAllocations();
+		};
+
+		static constexpr bool is_live_tracking_enabled()
+		{
+#if TRINEX_WITH_MEMORY_TRACKING
+			return true;
+#else
+			return false;
+#endif
+		}
+
+		static MemoryTag tag();
+		static const char* tag_name(MemoryTag tag);
+		static Stats stats(MemoryTag tag);
+
+		// Publishes allocation counters of the current frame, called by the engine once per frame
+		static void end_frame();
+
+		// Allocator hooks
+		static void on_allocate(usize size);
+		static void on_temp_allocate(usize size);
+		static void on_live_allocate(MemoryTag tag, usize size);
+		static void on_live_deallocate(MemoryTag tag, usize size);
+	};
+}// namespace Trinex
+
+#define trinex_memory_tag(tag) ::Trinex::MemoryTracker::TagScope TRINEX_CONCAT(trinex_memory_tag_, __LINE__)(::Trinex::MemoryTag::tag)
+
+#define trinex_expect_allocations(count)                                                                                         \
+	::Trinex::MemoryTracker::ExpectAllocations TRINEX_CONCAT(trinex_expect_allocations_, __LINE__)(count, __FILE__, __LINE__)
@@ -11,8 +11,12 @@ namespace Trinex
 {
 	class Package;
 	class Object;
+	class ObjectHandle;
 	class Path;
 
+	template<typename T>
+	class Coroutine;
+
 	ENGINE_EXPORT const char* operator""_localized(const char* line, usize len);
 
 	// Head of all classes in the Engine
@@ -64,8 +68,10 @@ namespace Trinex
 		Name m_name;
 
 		mutable Atomic<u32> m_references;
+		mutable Atomic<u32> m_gc_epoch;
 		mutable u32 m_child_index;
 		mutable u32 m_global_index;
+		u32 m_handle_index;
 
 	protected:
 		static class Refl::Class* m_static_class;
@@ -76,6 +82,7 @@ namespace Trinex
 	private:
 		// Setup object info
 		static Refl::Class* static_setup_next_object_info(Refl::Class* self = nullptr);
+		static void* static_allocate_pooled_instance(Refl::Class* self, usize size, usize alignment);
 		static void initialize_new_object(Object* object, StringView name, Object* owner);
 
 		template<typename T>
@@ -161,6 +168,10 @@ namespace Trinex
 		static Object* load_object(StringView fullname, SerializationFlags flags = {});
 		static Object* load_object_from_file(const Path& path, SerializationFlags flags = {});
 
+		// Reads and decompresses the asset on TaskGraph workers, deserialization and postload run on the logic thread.
+		// Must be called from the logic thread, the result can be awaited by another coroutine or polled with is_done()
+		static Coroutine<Object*> load_object_async(String fullname, SerializationFlags flags = {});
+
 		virtual bool rename(StringView name, Object* new_owner = nullptr);
 		const Name& name() const;
 
@@ -177,6 +188,7 @@ namespace Trinex
 		bool is_noname() const;
 		u32 child_index() const;
 		u32 global_index() const;
+		ObjectHandle handle() const;
 		virtual bool serialize(Archive& archive);
 		Path filepath() const;
 		bool is_editable() const;
@@ -217,7 +229,13 @@ namespace Trinex
 			else
 			{
 				if constexpr (std::is_base_of_v<Object, Type>)
-					static_setup_next_object_info(Type::static_reflection());
+				{
+					Refl::Class* self = Type::static_reflection();
+					static_setup_next_object_info(self);
+
+					if (void* place = static_allocate_pooled_instance(self, sizeof(Type), alignof(Type)))
+						return initialize_new_object_checked(new (place) Type(std::forward<Args>(args)...), name, owner);
+				}
 				return initialize_new_object_checked(trx_new Type(std::forward<Args>(args)...), name, owner);
 			}
 		}
@@ -341,6 +359,7 @@ namespace Trinex
 
 		virtual ~Object();
 		friend class PointerBase;
+		friend class ObjectHandle;
 		friend class Package;
 		friend class Archive;
 		friend class MemoryManager;
@@ -0,0 +1,68 @@
+#pragma once
+#include <Core/object.hpp>
+
+namespace Trinex
+{
+	// Weak reference to an object. The handle stores the index of the object slot and the generation of the slot,
+	// destroying the object increments the generation, so stale handles resolve to nullptr instead of a dangling pointer.
+	// Handles don't keep objects alive and aren't serialized
+	class ENGINE_EXPORT ObjectHandle final
+	{
+	public:
+		static constexpr u32 invalid_index = 0xFFFFFFFF;
+
+	private:
+		u32 m_index      = invalid_index;
+		u32 m_generation = 0;
+
+		static u32 allocate_slot(Object* object);
+		static void release_slot(u32 index);
+
+	public:
+		ObjectHandle() = default;
+		ObjectHandle(const Object* object);
+		ObjectHandle(const ObjectHandle&)            = default;
+		ObjectHandle& operator=(const ObjectHandle&) = default;
+		ObjectHandle& operator=(const Object* object);
+
+		Object* object() const;
+		bool is_valid() const;
+
+		template<typename T>
+		inline T* object() const
+		{
+			return Object::instance_cast<T>(object());
+		}
+
+		// Count of allocated slots, handle indices are always less than this value
+		static u32 static_slots_count();
+
+		// Resolves slot index to the object, returns nullptr for empty slots
+		static Object* static_find_object(u32 index);
+
+		inline ObjectHandle& reset()
+		{
+			m_index      = invalid_index;
+			m_generation = 0;
+			return *this;
+		}
+
+		inline u32 index() const { return m_index; }
+		inline u32 generation() const { return m_generation; }
+		inline bool operator==(const ObjectHandle& other) const = default;
+		inline explicit operator bool() const { return is_valid(); }
+
+		friend class Object;
+	};
+}// namespace Trinex
+
+namespace std
+{
+	template<>
+	struct hash<Trinex::ObjectHandle> {
+		size_t operator()(const Trinex::ObjectHandle& handle) const noexcept
+		{
+			return (static_cast<Trinex::u64>(handle.generation()) << 32) | handle.index();
+		}
+	};
+}// namespace std
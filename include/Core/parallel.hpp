@@ -0,0 +1,280 @@
+#pragma once
+#include <Core/etl/atomic.hpp>
+#include <Core/etl/vector.hpp>
+#include <Core/math/math.hpp>
+#include <Core/threading.hpp>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+
+namespace Trinex::Parallel
+{
+	static constexpr usize cache_line_size = 64;
+
+	// Minimal number of elements, that must be processed by one block to amortize the cost of block acquisition
+	static constexpr usize min_block_size = 256;
+
+	// Number of blocks per thread. Values greater than 1 give faster threads a chance to balance the load
+	static constexpr usize blocks_per_thread = 4;
+
+	// Number of elements of the specified size that fit into a single cache line
+	template<typename Type>
+	inline constexpr usize cache_line_elements()
+	{
+		return sizeof(Type) >= cache_line_size ? 1 : cache_line_size / sizeof(Type);
+	}
+
+	// Chooses a block size for count elements. Result is a multiple of grain, pass cache_line_elements<T>() as grain,
+	// so that blocks writing adjacent elements of an aligned array never share a cache line
+	inline usize block_size(usize count, usize grain = 1)
+	{
+		const usize threads = TaskGraph::instance()->workers() + 1;
+		usize block         = (count + threads * blocks_per_thread - 1) / (threads * blocks_per_thread);
+
+		block = Math::max(block, min_block_size);
+		block = ((block + grain - 1) / grain) * grain;
+		return block;
+	}
+
+	// Calls func(begin, end) for every block of the [0, count) range on TaskGraph workers and the calling thread.
+	// Returns after all blocks are processed. Block size is selected automatically when block is 0
+	template<typename Callable>
+	inline void for_each_range(usize count, Callable&& func, usize block = 0)
+	{
+		if (count == 0)
+			return;
+
+		if (block == 0)
+			block = block_size(count);
+
+		TaskGraph* graph   = TaskGraph::instance();
+		const usize blocks = (count + block - 1) / block;
+
+		if (blocks <= 1 || graph->workers() == 0)
+		{
+			func(usize(0), count);
+			return;
+		}
+
+		Atomic<usize> counter = 0;
+
+		Task task(Task::High, [&]() {
+			usize index;
+
+			while ((index = counter.fetch_add(1, etl::memory_order_relaxed)) < blocks)
+			{
+				const usize begin = index * block;
+				func(begin, Math::min(begin + block, count));
+			}
+		});
+
+		task.max_threads(Math::min<usize>(blocks, graph->workers() + 1));
+		graph->wait_for(task);
+	}
+
+	// Reduces [0, count) range. range_func(begin, end, identity) must return a reduced value of the range,
+	// combine(a, b) merges two reduced values. Partial results are combined in order, so combine must be
+	// associative, but it does not need to be commutative.
+	template<typename Type, typename RangeFunc, typename Combine>
+	inline Type reduce_range(usize count, Type identity, RangeFunc&& range_func, Combine&& combine, usize block = 0)
+	{
+		if (count == 0)
+			return identity;
+
+		if (block == 0)
+			block = block_size(count);
+
+		const usize blocks = (count + block - 1) / block;
+
+		if (blocks <= 1)
+			return range_func(usize(0), count, identity);
+
+		Vector<Type> partials(blocks, identity);
+
+		for_each_range(
+		        count, [&](usize begin, usize end) { partials[begin / block] = range_func(begin, end, identity); }, block);
+
+		Type result = partials[0];
+
+		for (usize index = 1; index < blocks; ++index)
+		{
+			result = combine(result, partials[index]);
+		}
+
+		return result;
+	}
+
+	template<typename Iterator, typename Type, typename Combine = std::plus<>>
+	inline Type reduce(Iterator first, Iterator last, Type init, Combine&& combine = {})
+	{
+		const usize count = static_cast<usize>(std::distance(first, last));
+
+		// init isn't an identity of combine, so only the first block starts from it, other blocks start from their first element
+		Type result = reduce_range(
+		        count, init,
+		        [&](usize begin, usize end, Type value) {
+			        Iterator it = first + begin;
+
+			        if (begin != 0)
+				        value = *it++;
+
+			        for (Iterator it_end = first + end; it != it_end; ++it) value = combine(value, *it);
+			        return value;
+		        },
+		        combine);
+
+		return result;
+	}
+
+	namespace Detail
+	{
+		template<bool inclusive, typename InputIt, typename OutputIt, typename Type, typename Combine>
+		inline OutputIt scan(InputIt first, InputIt last, OutputIt out, Type init, Combine& combine)
+		{
+			const usize count = static_cast<usize>(std::distance(first, last));
+
+			if (count == 0)
+				return out;
+
+			using OutputType   = std::remove_reference_t<decltype(*out)>;
+			const usize block  = block_size(count, cache_line_elements<OutputType>());
+			const usize blocks = (count + block - 1) / block;
+
+			auto scan_block = [&](usize begin, usize end, Type value) {
+				InputIt src  = first + begin;
+				OutputIt dst = out + begin;
+
+				for (usize i = begin; i < end; ++i, ++src, ++dst)
+				{
+					if constexpr (inclusive)
+					{
+						value = combine(value, *src);
+						*dst  = value;
+					}
+					else
+					{
+						Type current = *src;
+						*dst         = value;
+						value        = combine(value, current);
+					}
+				}
+			};
+
+			if (blocks <= 1)
+			{
+				scan_block(0, count, init);
+				return out + count;
+			}
+
+			// First pass: reduce every block
+			Vector<Type> offsets(blocks, init);
+
+			for_each_range(
+			        count,
+			        [&](usize begin, usize end) {
+				        InputIt src = first + begin;
+				        Type value  = *src;
+
+				        for (++src, ++begin; begin < end; ++begin, ++src) value = combine(value, *src);
+
+				        offsets[(end - 1) / block] = value;
+			        },
+			        block);
+
+			// Convert block sums to block offsets
+			Type carry = init;
+
+			for (Type& offset : offsets)
+			{
+				Type sum = offset;
+				offset   = carry;
+				carry    = combine(carry, sum);
+			}
+
+			// Second pass: scan every block starting from its offset
+			for_each_range(count, [&](usize begin, usize end) { scan_block(begin, end, offsets[begin / block]); }, block);
+			return out + count;
+		}
+	}// namespace Detail
+
+	// Parallel version of std::inclusive_scan. Input and output ranges may be the same
+	template<typename InputIt, typename OutputIt, typename Combine, typename Type>
+	inline OutputIt inclusive_scan(InputIt first, InputIt last, OutputIt out, Combine combine, Type init)
+	{
+		return Detail::scan<true>(first, last, out, init, combine);
+	}
+
+	template<typename InputIt, typename OutputIt>
+	inline OutputIt inclusive_scan(InputIt first, InputIt last, OutputIt out)
+	{
+		using Type = typename std::iterator_traits<InputIt>::value_type;
+		std::plus<> combine;
+		return Detail::scan<true>(first, last, out, Type(), combine);
+	}
+
+	// Parallel version of std::exclusive_scan. Input and output ranges may be the same
+	template<typename InputIt, typename OutputIt, typename Type, typename Combine = std::plus<>>
+	inline OutputIt exclusive_scan(InputIt first, InputIt last, OutputIt out, Type init, Combine combine = {})
+	{
+		return Detail::scan<false>(first, last, out, init, combine);
+	}
+
+	// Parallel stable merge sort: blocks are sorted independently, then merged pairwise in parallel passes.
+	// Elements must be move constructible and move assignable
+	template<typename Iterator, typename Compare = std::less<>>
+	inline void sort(Iterator first, Iterator last, Compare compare = {})
+	{
+		using Type = typename std::iterator_traits<Iterator>::value_type;
+
+		const usize count = static_cast<usize>(std::distance(first, last));
+		const usize block = block_size(count, cache_line_elements<Type>());
+
+		if (count <= block || TaskGraph::instance()->workers() == 0)
+		{
+			std::stable_sort(first, last, compare);
+			return;
+		}
+
+		for_each_range(count, [&](usize begin, usize end) { std::stable_sort(first + begin, first + end, compare); }, block);
+
+		// Sorted blocks are moved into the buffer once, after that levels are merged alternately into the input range
+		// and back into the buffer, so elements don't need a default constructor
+		Vector<Type> buffer(std::make_move_iterator(first), std::make_move_iterator(last));
+		Type* data = buffer.data();
+
+		auto merge_level = [&](auto src, auto dst, usize width) {
+			const usize pairs = (count + 2 * width - 1) / (2 * width);
+
+			for_each_range(
+			        pairs,
+			        [&](usize begin, usize end) {
+				        for (usize pair = begin; pair < end; ++pair)
+				        {
+					        const usize left  = pair * 2 * width;
+					        const usize mid   = Math::min(left + width, count);
+					        const usize right = Math::min(left + 2 * width, count);
+
+					        std::merge(std::make_move_iterator(src + left), std::make_move_iterator(src + mid),
+					                   std::make_move_iterator(src + mid), std::make_move_iterator(src + right), dst + left,
+					                   compare);
+				        }
+			        },
+			        1);
+		};
+
+		bool in_buffer = true;
+
+		for (usize width = block; width < count; width *= 2)
+		{
+			if (in_buffer)
+				merge_level(data, first, width);
+			else
+				merge_level(first, data, width);
+
+			in_buffer = !in_buffer;
+		}
+
+		if (in_buffer)
+			for_each_range(count, [&](usize begin, usize end) { std::move(data + begin, data + end, first + begin); }, block);
+	}
+}// namespace Trinex::Parallel
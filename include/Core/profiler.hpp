@@ -13,6 +13,8 @@
 #define trinex_profile_frame_mark_start(name) FrameMarkStart(name)
 #define trinex_profile_frame_mark_end(name) FrameMarkEnd(name)
 
+#define trinex_profile_plot(name, value) TracyPlot(name, value)
+
 #else
 #define trinex_profile_cpu()
 #define trinex_profile_cpu_n(name)
@@ -22,4 +24,5 @@
 #define trinex_profile_frame_mark_n(name)
 #define trinex_profile_frame_mark_start(name)
 #define trinex_profile_frame_mark_end(name)
+#define trinex_profile_plot(name, value)
 #endif
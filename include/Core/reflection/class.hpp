@@ -17,10 +17,24 @@ namespace Trinex
 		{
 			trinex_reflect_type(Class, Struct);
 
+		public:
+			struct PoolStatistics {
+				usize slabs          = 0;
+				usize slot_size      = 0;
+				usize live_objects   = 0;
+				usize peak_objects   = 0;
+				usize allocations    = 0;// Total number of objects allocated from the pool
+				usize reserved_bytes = 0;
+			};
+
 		private:
+			class Pool;
+
 			mutable Trinex::Object* m_singletone_object;
+			Pool* m_pool = nullptr;
 
 		private:
+			void* allocate_pooled_instance(usize size, usize alignment);
 			void script_object_constructor(void* object, StringView name = "", Trinex::Object* owner = nullptr);
 			inline void script_object_constructor_default(void* object) { script_object_constructor(object); }
 
@@ -49,10 +63,13 @@ namespace Trinex
 			Trinex::Object* create_placement_object(void* place, StringView name = "", Trinex::Object* owner = nullptr);
 			virtual Class& destroy_object(Trinex::Object* object);
 			Trinex::Object* singletone_instance() const;
+			bool is_pooled() const;
+			PoolStatistics pool_statistics() const;
 
 			using Struct::is_a;
 			const ScriptTypeInfo& find_valid_script_type_info() const;
 			static const Vector<Class*>& asset_classes();
+			static const Vector<Class*>& pooled_classes();
 			static void register_layout(ScriptBinding::Class& r, ClassInfo* info, DownCast downcast);
 
 			template<typename Type>
@@ -62,8 +79,11 @@ namespace Trinex
 				return is_a(Type::static_reflection());
 			}
 
+			~Class();
+
 			friend class Trinex::ScriptBinding::Class;
 			friend class Trinex::SingletoneBase;
+			friend class Trinex::Object;
 		};
 
 		template<typename T>
@@ -142,6 +162,7 @@ namespace Trinex
 			}
 
 			usize size() const override { return sizeof(T); }
+			usize alignment() const override { return alignof(T); }
 		};
 	}// namespace Refl
 }// namespace Trinex
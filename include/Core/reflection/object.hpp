@@ -43,7 +43,7 @@ namespace Trinex::Refl
 	class ENGINE_EXPORT Object
 	{
 	private:
-		using MetaData       = Map<Name, Any, Name::HashFunction>;
+		using MetaData       = NodeMap<Name, Any, Name::HashFunction>;
 		MetaData* m_metadata = nullptr;
 		Object* m_owner      = nullptr;
 
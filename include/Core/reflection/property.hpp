@@ -1,5 +1,6 @@
 #pragma once
 #include <Core/etl/any.hpp>
+#include <Core/etl/templates.hpp>
 #include <Core/etl/type_traits.hpp>
 #include <Core/math/angle.hpp>
 #include <Core/reflection/object.hpp>
@@ -153,6 +154,9 @@ private:
 		virtual Property& item_flags(BitMask flags);
 		Property& render_function(RenderFunction function);
 
+		// Offset of the value from the context, or -1 when the address can't be computed without the context
+		virtual isize offset() const;
+
 		static void register_layout(ScriptBinding::Class& r, ClassInfo* info, DownCast downcast);
 
 		template<typename T>
@@ -622,6 +626,7 @@ private:
 
 			void* address(void* context) const { return context; }
 			const void* address(const void* context) const { return context; }
+			isize offset() const { return 0; }
 
 			static constexpr inline bool should_trigger_owner_event = false;
 		};
@@ -645,6 +650,8 @@ private:
 				return &(instance->*prop);
 			}
 
+			isize offset() const { return static_cast<isize>(offset_of(prop)); }
+
 			static constexpr inline bool should_trigger_owner_event = std::is_base_of_v<Trinex::Object, Owner>;
 		};
 
@@ -657,6 +664,7 @@ private:
 
 			void* address(void*) const { return prop; }
 			const void* address(const void*) const { return prop; }
+			isize offset() const { return -1; }
 
 			static constexpr inline bool should_trigger_owner_event = false;
 		};
@@ -673,6 +681,7 @@ private:
 
 			void* address(void* context) override { return m_accessor.address(context); }
 			const void* address(const void* context) const override { return m_accessor.address(context); }
+			isize offset() const override { return m_accessor.offset(); }
 
 			usize size() const override { return sizeof(Type); }
 			usize alignment() const override { return alignof(Type); }
@@ -31,6 +31,8 @@ namespace Trinex::Refl
 			else
 				return reinterpret_cast<const u8*>(context) + m_offset;
 		}
+
+		isize offset() const override { return dereference ? -1 : static_cast<isize>(m_offset); }
 	};
 
 	using ScriptBooleanProperty = ScriptProperty<BooleanProperty>;
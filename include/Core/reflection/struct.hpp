@@ -1,4 +1,5 @@
 #pragma once
+#include <Core/etl/atomic.hpp>
 #include <Core/etl/set.hpp>
 #include <Core/etl/type_traits.hpp>
 #include <Core/reflection/scoped_type.hpp>
@@ -33,6 +34,7 @@ namespace Trinex::Refl
 				IsNative        = BIT(3),
 				IsScriptable    = BIT(4),
 				IsAsset         = BIT(5),
+				IsPooled        = BIT(6),// Native instances of the class are allocated from a per-class slab pool
 			};
 
 			trinex_bitfield_enum_struct(Flags, u8);
@@ -48,8 +50,29 @@ namespace Trinex::Refl
 		Set<Struct*> m_derived_structs;
 		mutable Struct* m_parent = nullptr;
 
+		// Pre-order interval of the struct in the reflection hierarchy. Struct A is derived from struct B when
+		// B.begin <= A.begin < B.end. Zero means that the struct isn't numbered yet
+		Atomic<u32> m_order_begin = 0;
+		Atomic<u32> m_order_end   = 0;
+		u32 m_order_next          = 0;// First free index for structs derived later
+
+		static Atomic<u32> s_order_sequence;// Odd while the hierarchy is renumbered
+
+		u32 assign_order(u32 begin);
+		void insert_into_order();
+		static void rebuild_hierarchy_order();
+		bool is_a_slow(const Struct* other) const;
+
 		class Group* m_group = nullptr;
 
+		// Compiled on first serialization with a schema table, dropped when the properties of the struct change
+		struct SerializationPlan;
+		Atomic<SerializationPlan*> m_serialization_plan = nullptr;
+
+		const SerializationPlan& serialization_plan();
+		void reset_serialization_plan();
+		bool serialize_compiled(void* object, Archive& ar);
+
 	protected:
 		void destroy_derived_structs();
 
@@ -101,7 +124,28 @@ namespace Trinex::Refl
 		bool is_scriptable() const;
 
 		using Super::is_a;
-		bool is_a(const Struct* other) const;
+
+		inline bool is_a(const Struct* other) const
+		{
+			const u32 sequence = s_order_sequence.load(etl::memory_order_acquire);
+
+			if (other && (sequence & 1) == 0)
+			{
+				const u32 begin       = m_order_begin.load(etl::memory_order_relaxed);
+				const u32 other_begin = other->m_order_begin.load(etl::memory_order_relaxed);
+				const u32 other_end   = other->m_order_end.load(etl::memory_order_relaxed);
+
+				std::atomic_thread_fence(etl::memory_order_acquire);
+
+				if (begin != 0 && other_begin != 0 && s_order_sequence.load(etl::memory_order_relaxed) == sequence)
+					return other_begin <= begin && begin < other_end;
+			}
+
+			return is_a_slow(other);
+		}
+
+		// Renumbers the whole reflection hierarchy, leaving room for structs registered later
+		static void update_hierarchy_order();
 
 		const Vector<Property*>& properties() const;
 		Property* find_property(StringView name);
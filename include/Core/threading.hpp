@@ -64,7 +64,7 @@ namespace Trinex
 	private:
 		Task(Priority priority);
 
-		void* data(usize size);
+		void* data(usize size, usize align);
 
 	public:
 		Task();
@@ -73,14 +73,14 @@ namespace Trinex
 		Task(Callable&& callable, Args&&... args) : Task(Middle)
 		{
 			using FuncType = FunctionImpl<std::decay_t<Callable>, std::decay_t<Args>...>;
-			new (data(sizeof(FuncType))) FuncType(etl::forward<Callable>(callable), etl::forward<Args>(args)...);
+			new (data(sizeof(FuncType), alignof(FuncType))) FuncType(etl::forward<Callable>(callable), etl::forward<Args>(args)...);
 		}
 
 		template<typename Callable, typename... Args, typename = std::enable_if_t<!std::is_same_v<std::decay_t<Callable>, Task>>>
 		Task(Priority priority, Callable&& callable, Args&&... args) : Task(priority)
 		{
 			using FuncType = FunctionImpl<std::decay_t<Callable>, std::decay_t<Args>...>;
-			new (data(sizeof(FuncType))) FuncType(etl::forward<Callable>(callable), etl::forward<Args>(args)...);
+			new (data(sizeof(FuncType), alignof(FuncType))) FuncType(etl::forward<Callable>(callable), etl::forward<Args>(args)...);
 		}
 
 		Task(const Task& task);
@@ -90,6 +90,11 @@ namespace Trinex
 		~Task();
 
 		static u8 worker_index();
+
+		// Number of heap allocations performed by the task system: task objects, dependency nodes and functors
+		// exceeding the inline storage. Stays constant in steady state, when all objects are reused from the caches
+		static usize heap_allocations();
+
 		Task& max_threads(u32 count);
 		Task& add_dependent(const Task& dependent);
 		Task& add_dependent(Task&& dependent);
@@ -144,6 +149,17 @@ namespace Trinex
 
 	class ENGINE_EXPORT TaskGraph final
 	{
+	public:
+		// Times are in nanoseconds
+		struct WorkerStats {
+			u64 executed    = 0;// Number of executed tasks
+			u64 stolen      = 0;// Number of tasks stolen from other workers
+			u64 busy_time   = 0;// Time spent executing tasks
+			u64 idle_time   = 0;// Time spent parked without work
+			u64 wait_time   = 0;// Time spent waiting for a free slot in the shared injection queue
+			u64 queue_depth = 0;// High-water mark of the task queue depth
+		};
+
 	private:
 		class TaskGraphImpl* m_impl;
 
@@ -157,6 +173,18 @@ namespace Trinex
 		TaskGraph& add_task(const Task& task);
 		TaskGraph& wait_for(const Task& task);
 
+		// Schedules continuation after task, returns false if task is already executed
+		bool add_continuation(const Task& task, const Task& continuation);
+
+		// Low priority tasks are deferred once the frame budget (in seconds) is exhausted, until end_frame is called
+		TaskGraph& begin_frame(f32 budget);
+		TaskGraph& end_frame();
+
+		// Returns statistics of the worker with the specified index. Index equal to workers() returns
+		// statistics of external threads: tasks they executed while helping in wait_for, and the injection queue state
+		WorkerStats worker_stats(u32 index) const;
+		TaskGraph& reset_stats();
+
 
 		template<typename Callable>
 		inline TaskGraph& for_each(usize count, Callable&& func, usize block = 64, u32 max_threads = 0xFFFFU)
@@ -43,6 +43,7 @@ namespace Trinex
 		};
 
 		static ENGINE_EXPORT Name none;
+		static constexpr u32 invalid_index = 0xFFFFFFFF;
 
 	private:
 		u32 m_index;
@@ -87,7 +88,7 @@ namespace Trinex
 		operator const String&() const;
 		operator StringView() const;
 
-		inline bool is_valid() const { return m_index != 0xFFFFFFFF; }
+		inline bool is_valid() const { return m_index != invalid_index; }
 		inline u32 index() const { return m_index; }
 		inline usize length() const { return to_string().length(); }
 
@@ -12,8 +12,8 @@ namespace Trinex
 		trinex_class(SkeletalMeshComponent, MeshComponent);
 
 	private:
-		class SkeletalMesh* m_mesh = nullptr;
-		RHIBuffer* m_bones         = nullptr;
+		Pointer<class SkeletalMesh> m_mesh = nullptr;
+		RHIBuffer* m_bones                 = nullptr;
 
 	public:
 		using MeshComponent::material;
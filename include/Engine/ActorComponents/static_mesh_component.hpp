@@ -12,10 +12,10 @@ namespace Trinex
 		trinex_class(StaticMeshComponent, MeshComponent);
 
 	private:
-		class StaticMesh* m_mesh = nullptr;
-		u32 m_transform          = 0;
-		u32 m_geometry           = 0;
-		u32 m_primitive          = 0;
+		Pointer<class StaticMesh> m_mesh = nullptr;
+		u32 m_transform                  = 0;
+		u32 m_geometry                   = 0;
+		u32 m_primitive                  = 0;
 
 	public:
 		using MeshComponent::material;
@@ -3,6 +3,7 @@
 #include <Core/etl/allocator.hpp>
 #include <Core/etl/map.hpp>
 #include <Core/etl/set.hpp>
+#include <Core/etl/small_vector.hpp>
 #include <Core/etl/type_traits.hpp>
 #include <Core/etl/vector.hpp>
 #include <RHI/enums.hpp>
@@ -20,6 +21,9 @@ namespace Trinex::RenderGraph
 	template<typename T>
 	using RGVector = Vector<T, FrameAllocator<T>>;
 
+	template<typename T, usize N>
+	using RGSmallVector = SmallVector<T, N, FrameAllocator<T>>;
+
 	template<typename Key>
 	using RGSet = Set<Key, Hash<Key>, std::equal_to<Key>, FrameAllocator<Key>>;
 
@@ -52,9 +56,9 @@ namespace Trinex::RenderGraph
 	private:
 		struct Node {
 			Pass* pass;
-			RGVector<Node*> dependencies;
+			RGSmallVector<Node*, 8> dependencies;
 
-			inline Node() : pass(nullptr) { dependencies.reserve(8); }
+			inline Node() : pass(nullptr) {}
 
 			inline bool is_executed() const;
 			inline bool is_empty() const;
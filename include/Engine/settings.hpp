@@ -9,8 +9,11 @@ namespace Trinex::Settings
 	extern ENGINE_EXPORT String current_language;
 	extern ENGINE_EXPORT u32 num_threads;
 	extern ENGINE_EXPORT i32 lz4_compression_level;
-	extern ENGINE_EXPORT i32 gc_max_object_per_tick;
+	extern ENGINE_EXPORT u32 lz4_block_size;
+	extern ENGINE_EXPORT float gc_time_budget;
+	extern ENGINE_EXPORT u32 gc_mark_threads;
 	extern ENGINE_EXPORT i32 fps_limit;
+	extern ENGINE_EXPORT float low_priority_tasks_budget;
 	extern ENGINE_EXPORT float screen_percentage;
 	extern ENGINE_EXPORT Vector<String> languages;
 	extern ENGINE_EXPORT Vector<String> systems;
@@ -23,6 +26,7 @@ namespace Trinex::Settings
 		extern ENGINE_EXPORT u32 shadow_map_size;
 		extern ENGINE_EXPORT bool force_keep_cpu_resources;
 		extern ENGINE_EXPORT float anisotropy;
+		extern ENGINE_EXPORT u32 frames_in_flight;
 	}// namespace Rendering
 
 	namespace Window
@@ -2,6 +2,7 @@
 #include <Core/etl/map.hpp>
 #include <Core/etl/object_tree_node.hpp>
 #include <Core/object.hpp>
+#include <Core/pointer.hpp>
 #include <Graphics/enums.hpp>
 #include <Graphics/material_parameter.hpp>
 #include <RHI/structures.hpp>
@@ -93,7 +94,7 @@ namespace Trinex
 		trinex_class(MaterialInstance, MaterialInterface);
 
 	private:
-		MaterialInterface* m_parent = nullptr;
+		Pointer<MaterialInterface> m_parent = nullptr;
 
 	public:
 		MaterialInstance();
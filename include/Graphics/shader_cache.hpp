@@ -64,7 +64,7 @@ namespace Trinex
 	};
 
 	struct ENGINE_EXPORT PipelineLibraryCacheManifest {
-		Map<String, PipelineLibraryCacheIndexEntry> entries;
+		NodeMap<String, PipelineLibraryCacheIndexEntry> entries;// find() returns pointers to the elements
 		String rhi_name;
 		bool is_loaded = false;
 		bool is_dirty  = false;
@@ -4,6 +4,7 @@
 #include <Core/engine_types.hpp>
 #include <Core/etl/map.hpp>
 #include <Core/etl/singletone.hpp>
+#include <Core/etl/small_vector.hpp>
 #include <Core/etl/vector.hpp>
 #include <Core/math/vector.hpp>
 #include <Core/tickable.hpp>
@@ -175,6 +176,8 @@ namespace Trinex
 	};
 
 	struct RoutedEvent : public Event {
+		using Route = SmallVector<EventTarget*, 16>;
+
 		EventPhase phase            = EventPhase::Undefined;
 		EventTarget* routing_root   = nullptr;
 		EventTarget* target         = nullptr;
@@ -182,7 +185,7 @@ namespace Trinex
 		void* payload               = nullptr;
 		usize payload_size          = 0;
 		EventDispatchResult result;
-		Vector<EventTarget*> route;
+		Route route;
 
 		RoutedEvent() = default;
 		explicit RoutedEvent(const EventHeader& value) : Event(value) {}
@@ -278,7 +281,7 @@ namespace Trinex
 		static EventDispatchResult merge_result(EventDispatchResult& destination, const EventDispatchResult& source);
 		static void finalize_event_result(RoutedEvent& event);
 		static bool should_dispatch_phase(const RoutedEvent& event, EventPhase phase);
-		Vector<EventTarget*> build_route(EventTarget* target, EventTarget* routing_root) const;
+		RoutedEvent::Route build_route(EventTarget* target, EventTarget* routing_root) const;
 		EventDispatchResult dispatch_listeners(const ListenerList& listeners, RoutedEvent& event) const;
 		EventDispatchResult notify_listeners(RoutedEvent& event);
 		EventDispatchResult dispatch_single_phase(RoutedEvent& event, EventPhase phase, EventTarget* target);
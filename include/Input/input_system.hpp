@@ -172,9 +172,10 @@ namespace Trinex
 	private:
 		friend class Singletone<InputSystem, Tickable>;
 
-		Map<DeviceId, InputDevice> m_devices;
-		Map<DeviceId, InputDeviceState> m_device_states;
-		Map<InputUserId, InputContextStack> m_user_contexts;
+		// device(), device_state() and context_stack() return pointers and references to the elements
+		NodeMap<DeviceId, InputDevice> m_devices;
+		NodeMap<DeviceId, InputDeviceState> m_device_states;
+		NodeMap<InputUserId, InputContextStack> m_user_contexts;
 		Vector<InputActionEvent> m_pending_action_events;
 		RawInputEventBatch m_pending_raw_events;
 		InputCommandBuffer m_command_buffer;
@@ -243,8 +244,8 @@ namespace Trinex
 		bool supports_text_input(DeviceId device_id) const;
 		bool supports_text_input_for_user(InputUserId user_id = 0) const;
 
-		const Map<DeviceId, InputDeviceState>& device_states() const;
-		const Map<DeviceId, InputDevice>& devices() const;
+		const NodeMap<DeviceId, InputDeviceState>& device_states() const;
+		const NodeMap<DeviceId, InputDevice>& devices() const;
 		const Vector<InputActionEvent>& pending_action_events() const;
 		const RawInputEventBatch& pending_raw_events() const;
 
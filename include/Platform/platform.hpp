@@ -43,6 +43,13 @@ namespace Trinex
 		}// namespace EventSystem
 
 		ENGINE_EXPORT VFS::FileSystem* create_filesystem(const Path& mount, const Path& path);
+
+		// Maps the whole native file into memory for reading. Returns nullptr if the file can't be mapped or is empty
+		ENGINE_EXPORT const void* map_file(const Path& path, usize& size);
+		ENGINE_EXPORT void unmap_file(const void* data, usize size);
+
+		// Hints that the mapped file will be read sequentially from start to end, so the OS can read it ahead
+		ENGINE_EXPORT void advise_sequential_read(const void* data, usize size);
 		ENGINE_EXPORT VFS::FileWatcherBackend* create_file_watcher();
 
 		namespace WindowManager
@@ -0,0 +1,12 @@
+#pragma once
+#include <Core/coroutine.hpp>
+#include <RHI/handles.hpp>
+
+namespace Trinex
+{
+	// Suspends the coroutine until the fence is signaled: co_await *fence
+	inline auto operator co_await(RHIFence& fence)
+	{
+		return wait_until([&fence]() { return fence.is_signaled(); });
+	}
+}// namespace Trinex
@@ -264,7 +264,7 @@ namespace Trinex
 
 		// Hash render target formats
 		{
-			hash = memory_hash(m_framebuffer.formats, sizeof(m_framebuffer.formats), hash);
+			hash = memory_hash_fast(m_framebuffer.formats, sizeof(m_framebuffer.formats), hash);
 		}
 
 		// Submit vertex attributes
@@ -285,7 +285,7 @@ namespace Trinex
 				va.stream  = va_state.stream;
 				va.rate    = static_cast<u8>(vs_state.rate);
 
-				hash = memory_hash(&va, sizeof(va), hash);
+				hash = memory_hash_fast(&va, sizeof(va), hash);
 			}
 		}
 
@@ -110,7 +110,7 @@ namespace Trinex
 		std::sort(descriptors, descriptors + descriptors_count);
 
 		u64 hash = static_cast<u64>(static_cast<VkShaderStageFlags>(stages));
-		hash     = memory_hash(descriptors, descriptors_count * sizeof(Descriptor), hash);
+		hash     = memory_hash_fast(descriptors, descriptors_count * sizeof(Descriptor), hash);
 
 		ScopeLock lock(m_section);
 		auto search_result = m_pipeline_layouts.equal_range(hash);
@@ -495,7 +495,7 @@ namespace Trinex
 			}
 		}
 
-		u64 hash               = memory_hash(bindings, count * sizeof(Binding), reinterpret_cast<u64>(layout));
+		u64 hash               = memory_hash_fast(bindings, count * sizeof(Binding), reinterpret_cast<u64>(layout));
 		vk::DescriptorSet& set = m_current_cache->table[hash];
 
 		if (set)
@@ -357,7 +357,7 @@ namespace Trinex
 
 	u64 VulkanMeshPipeline::KeyHasher::operator()(const Key& key) const
 	{
-		return memory_hash(&key, sizeof(key));
+		return memory_hash_fast(&key, sizeof(key));
 	}
 
 	VulkanMeshPipeline::VulkanMeshPipeline(const RHIMeshPipelineDesc& desc)
@@ -1,5 +1,6 @@
 #include <Core/archive.hpp>
 #include <Core/buffer_manager.hpp>
+#include <Core/etl/small_vector.hpp>
 #include <Core/object.hpp>
 #include <Core/package.hpp>
 #include <Core/reflection/class.hpp>
@@ -7,7 +8,18 @@
 
 namespace Trinex
 {
-	static FORCE_INLINE Refl::Class* find_class(const Vector<Name>& hierarchy)
+	// Names of the object class and its parents, without the root class
+	using ClassHierarchy = SmallVector<Name, 8>;
+
+	static FORCE_INLINE void build_hierarchy(const Refl::Struct* self, ClassHierarchy& hierarchy)
+	{
+		for (const Refl::Struct* current = self; current && current->parent(); current = current->parent())
+		{
+			hierarchy.emplace_back(current->full_name());
+		}
+	}
+
+	static FORCE_INLINE Refl::Class* find_class(const ClassHierarchy& hierarchy)
 	{
 		Refl::Class* instance = nullptr;
 
@@ -22,6 +34,42 @@ namespace Trinex
 		return instance;
 	}
 
+	u32 Archive::ImportTable::add(const String& path)
+	{
+		auto it = indices.find(path);
+
+		if (it != indices.end())
+			return it->second;
+
+		const u32 index = static_cast<u32>(paths.size());
+		paths.push_back(path);
+		indices.insert({path, index});
+		return index;
+	}
+
+	bool Archive::SchemaTable::Field::serialize(Archive& ar)
+	{
+		return ar.serialize(name, size);
+	}
+
+	bool Archive::SchemaTable::Schema::serialize(Archive& ar)
+	{
+		return ar.serialize(name, hash, fields);
+	}
+
+	u32 Archive::SchemaTable::add(Refl::Struct* self, const Schema& schema)
+	{
+		auto it = indices.find(self);
+
+		if (it != indices.end())
+			return it->second;
+
+		const u32 index = static_cast<u32>(schemas.size());
+		schemas.push_back(schema);
+		indices.insert({self, index});
+		return index;
+	}
+
 	Archive::Archive() : m_reader(nullptr), m_is_saving(false), m_process_status(false) {}
 
 	Archive::Archive(BufferReader* reader) : m_is_saving(false)
@@ -53,10 +101,14 @@ namespace Trinex
 		m_reader         = other.m_reader;
 		m_process_status = other.m_process_status;
 		m_is_saving      = other.m_is_saving;
+		imports          = other.imports;
+		schemas          = other.schemas;
 
 		other.m_process_status = false;
 		other.m_reader         = nullptr;
 		other.m_is_saving      = false;
+		other.imports          = nullptr;
+		other.schemas          = nullptr;
 
 		return *this;
 	}
@@ -207,13 +259,14 @@ namespace Trinex
 	{
 		if (is_saving())
 		{
-			auto hierarchy = object->class_instance()->hierarchy(1);
+			ClassHierarchy hierarchy;
+			build_hierarchy(object->class_instance(), hierarchy);
 			serialize(hierarchy);
 			return object->serialize(*this);
 		}
 		else
 		{
-			Vector<Name> hierarchy;
+			ClassHierarchy hierarchy;
 			serialize(hierarchy);
 
 			Refl::Class* self = find_class(hierarchy);
@@ -247,7 +300,7 @@ namespace Trinex
 			if (!valid)
 			{
 				trinex_error(Log::Core, "Failed to load object");
-				trx_delete object;
+				object->class_instance()->destroy_object(object);
 				object = nullptr;
 			}
 			else
@@ -260,7 +313,34 @@ namespace Trinex
 
 	bool Archive::serialize_object_ref(Object*& object)
 	{
-		if (is_saving())
+		if (imports)
+		{
+			u32 index = ImportTable::none;
+
+			if (is_saving() && object)
+				index = imports->add(object->full_name());
+
+			serialize(index);
+
+			if (is_reading())
+			{
+				if (index == ImportTable::none)
+				{
+					object = nullptr;
+				}
+				else if (index < imports->paths.size())
+				{
+					object = Object::load_object(imports->paths[index]);
+				}
+				else
+				{
+					trinex_error(Log::Core, "Invalid import index %u, the import table has %zu entries", index,
+					             imports->paths.size());
+					object = nullptr;
+				}
+			}
+		}
+		else if (is_saving())
 		{
 			String name = object ? object->full_name() : "";
 			usize size  = name.length();
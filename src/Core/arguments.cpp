@@ -4,7 +4,7 @@
 
 namespace Trinex
 {
-	Map<String, Arguments::Argument> Arguments::m_arguments;
+	NodeMap<String, Arguments::Argument> Arguments::m_arguments;
 	i32 Arguments::m_argc          = 0;
 	const char** Arguments::m_argv = nullptr;
 
@@ -153,7 +153,7 @@ namespace Trinex
 		m_arguments.clear();
 	}
 
-	const Map<String, Arguments::Argument>& Arguments::args()
+	const NodeMap<String, Arguments::Argument>& Arguments::args()
 	{
 		return m_arguments;
 	}
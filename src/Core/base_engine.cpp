@@ -2,6 +2,7 @@
 #include <Core/config_manager.hpp>
 #include <Core/etl/allocator.hpp>
 #include <Core/garbage_collector.hpp>
+#include <Core/memory_tracker.hpp>
 #include <Core/profiler.hpp>
 #include <Core/reflection/class.hpp>
 #include <Core/threading.hpp>
@@ -76,6 +77,10 @@ namespace Trinex
 		m_prev_time  = current_time;
 		++m_frame_index;
 
+		// Low priority background tasks must not steal workers from frame critical work after the budget is spent
+		TaskGraph* task_graph = TaskGraph::instance();
+		task_graph->begin_frame(Settings::low_priority_tasks_budget * 0.001f);
+
 		GarbageCollector::update(m_delta_time);
 
 		StackByteAllocator::reset();
@@ -86,6 +91,7 @@ namespace Trinex
 
 		if (RHI* rhi = RHI::instance())
 		{
+			trinex_memory_tag(RHI);
 			rhi->update(m_delta_time);
 		}
 
@@ -96,12 +102,15 @@ namespace Trinex
 			for (usize i = 0; i < viewports.size(); ++i)
 			{
 				trinex_profile_cpu_n("RenderViewport::update");
+				trinex_memory_tag(Render);
 				auto viewport = viewports[i];
 				viewport->update(m_delta_time);
 			}
 		}
 
 		Tickable::for_each_end_frame(m_frame_index);
+		task_graph->end_frame();
+		MemoryTracker::end_frame();
 		return 0;
 	}
 
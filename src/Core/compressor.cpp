@@ -1,34 +1,174 @@
 #include <Core/compressor.hpp>
+#include <Core/etl/atomic.hpp>
+#include <Core/math/math.hpp>
+#include <Core/threading.hpp>
 #include <Engine/settings.hpp>
+#include <cstring>
 #include <lz4hc.h>
 
 namespace Trinex::Compressor
 {
+	// Compressed data is split into independent blocks, so that blocks can be compressed and decompressed in parallel
+	// Layout: Header | u32 size of each block | data of the blocks
+	// Blocks which can't be compressed are stored as is and marked with the stored bit in the size.
+	//
+	// Legacy format is the usize raw size followed by a single LZ4 block. The magic has the highest bit set,
+	// so it is never equal to the size of a legacy buffer
+	static constexpr u64 s_magic          = 0x8000'0000'4B424C54;// TLBK
+	static constexpr u32 s_stored_bit     = 1U << 31;
+	static constexpr u32 s_min_block_size = 4 * 1024;
+	static constexpr u32 s_max_block_size = 64 * 1024 * 1024;
+
+	struct Header {
+		u64 magic;
+		u64 raw_size;
+		u32 block_size;
+		u32 blocks_count;
+	};
+
+	static void decompress_legacy(const u8* src, usize src_size, Buffer& dst)
+	{
+		trinex_verify(src_size >= sizeof(usize));
+
+		usize raw_size;
+		std::memcpy(&raw_size, src, sizeof(usize));
+
+		int input_size = static_cast<int>(src_size - sizeof(usize));
+		dst.resize(raw_size);
+		int out_size = static_cast<int>(dst.size());
+
+		out_size = LZ4_decompress_safe(reinterpret_cast<const char*>(src + sizeof(usize)), reinterpret_cast<char*>(dst.data()),
+		                               input_size, out_size);
+		trinex_verify(out_size >= 0);
+		dst.resize(out_size);
+	}
 
 	ENGINE_EXPORT void compress(const Buffer& src, Buffer& dst)
 	{
-		int input_size = static_cast<int>(src.size());
-		int out_size   = LZ4_compressBound(input_size);
+		const u32 block_size   = Math::clamp(Settings::lz4_block_size, s_min_block_size, s_max_block_size);
+		const u32 blocks_count = static_cast<u32>((src.size() + block_size - 1) / block_size);
+		const usize bound      = static_cast<usize>(LZ4_compressBound(static_cast<int>(block_size)));
+
+		// Every block is compressed into its own slot, the slots are packed after all blocks are done
+		Buffer slots(bound * blocks_count);
+		Vector<u32> sizes(blocks_count);
+
+		auto compress_block = [&](usize index) {
+			const usize offset = index * block_size;
+			const int size     = static_cast<int>(Math::min<usize>(block_size, src.size() - offset));
+			const char* input  = reinterpret_cast<const char*>(src.data() + offset);
+			char* output       = reinterpret_cast<char*>(slots.data() + index * bound);
+
+			int compressed = LZ4_compress_HC(input, output, size, static_cast<int>(bound), Settings::lz4_compression_level);
+
+			if (compressed <= 0 || compressed >= size)
+			{
+				std::memcpy(output, input, size);
+				sizes[index] = static_cast<u32>(size) | s_stored_bit;
+			}
+			else
+			{
+				sizes[index] = static_cast<u32>(compressed);
+			}
+		};
+
+		TaskGraph::instance()->for_each(blocks_count, compress_block, 1);
+
+		usize data_size = 0;
+
+		for (u32 size : sizes)
+		{
+			data_size += size & ~s_stored_bit;
+		}
 
 		dst.clear();
-		dst.resize(out_size + sizeof(usize));
+		dst.resize(sizeof(Header) + sizes.size() * sizeof(u32) + data_size);
 
-		out_size = LZ4_compress_HC(reinterpret_cast<const char*>(src.data()), reinterpret_cast<char*>(dst.data() + sizeof(usize)),
-		                           input_size, out_size, Settings::lz4_compression_level);
+		Header* header       = reinterpret_cast<Header*>(dst.data());
+		header->magic        = s_magic;
+		header->raw_size     = src.size();
+		header->block_size   = block_size;
+		header->blocks_count = blocks_count;
 
-		dst.resize(out_size + sizeof(usize));
-		(*reinterpret_cast<usize*>(dst.data())) = src.size();
+		std::memcpy(dst.data() + sizeof(Header), sizes.data(), sizes.size() * sizeof(u32));
+		u8* data = dst.data() + sizeof(Header) + sizes.size() * sizeof(u32);
+
+		for (u32 index = 0; index < blocks_count; ++index)
+		{
+			const u32 size = sizes[index] & ~s_stored_bit;
+			std::memcpy(data, slots.data() + index * bound, size);
+			data += size;
+		}
 	}
 
 	ENGINE_EXPORT void decompress(const Buffer& src, Buffer& dst)
 	{
-		int input_size = static_cast<int>(src.size() - sizeof(usize));
-		dst.resize(*reinterpret_cast<const usize*>(src.data()));
-		int out_size = static_cast<int>(dst.size());
+		decompress(src.data(), src.size(), dst);
+	}
 
-		out_size = LZ4_decompress_safe(reinterpret_cast<const char*>(src.data() + sizeof(usize)),
-		                               reinterpret_cast<char*>(dst.data()), input_size, out_size);
-		trinex_verify(out_size >= 0);
-		dst.resize(out_size);
+	ENGINE_EXPORT void decompress(const u8* src, usize src_size, Buffer& dst)
+	{
+		Header header;
+
+		if (src_size >= sizeof(Header))
+			std::memcpy(&header, src, sizeof(Header));
+
+		if (src_size < sizeof(Header) || header.magic != s_magic)
+		{
+			decompress_legacy(src, src_size, dst);
+			return;
+		}
+
+		// Every block except the last one must be full, otherwise the size of the last block underflows
+		trinex_verify(header.block_size > 0 && header.block_size <= s_max_block_size);
+		const u64 blocks_count = header.raw_size / header.block_size + (header.raw_size % header.block_size != 0);
+		trinex_verify(header.blocks_count == blocks_count);
+
+		const usize table_end = sizeof(Header) + static_cast<usize>(header.blocks_count) * sizeof(u32);
+		trinex_verify(table_end <= src_size);
+
+		Vector<u32> sizes(header.blocks_count);
+		Vector<usize> offsets(header.blocks_count);
+		std::memcpy(sizes.data(), src + sizeof(Header), sizes.size() * sizeof(u32));
+
+		usize offset = table_end;
+
+		for (u32 index = 0; index < header.blocks_count; ++index)
+		{
+			offsets[index] = offset;
+			offset += sizes[index] & ~s_stored_bit;
+		}
+
+		trinex_verify(offset <= src_size);
+		dst.resize(header.raw_size);
+
+		Atomic<bool> is_valid = true;
+
+		auto decompress_block = [&](usize index) {
+			const usize raw_offset = index * header.block_size;
+			const usize raw_size   = Math::min<usize>(header.block_size, header.raw_size - raw_offset);
+			const u32 size         = sizes[index] & ~s_stored_bit;
+			const u8* input        = src + offsets[index];
+			u8* output             = dst.data() + raw_offset;
+
+			if (sizes[index] & s_stored_bit)
+			{
+				if (size != raw_size)
+					is_valid.store(false, etl::memory_order_relaxed);
+				else
+					std::memcpy(output, input, raw_size);
+				return;
+			}
+
+			int out_size = LZ4_decompress_safe(reinterpret_cast<const char*>(input), reinterpret_cast<char*>(output),
+			                                   static_cast<int>(size), static_cast<int>(raw_size));
+
+			if (out_size < 0 || static_cast<usize>(out_size) != raw_size)
+				is_valid.store(false, etl::memory_order_relaxed);
+		};
+
+		TaskGraph::instance()->for_each(header.blocks_count, decompress_block, 1);
+
+		trinex_verify(is_valid.load(etl::memory_order_relaxed));
 	}
 }// namespace Trinex::Compressor
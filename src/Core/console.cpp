@@ -1,10 +1,16 @@
 #include <Core/console.hpp>
 #include <Core/etl/algorithm.hpp>
+#include <Core/etl/allocator.hpp>
 #include <Core/etl/charconv.hpp>
 #include <Core/etl/map.hpp>
 #include <Core/file_manager.hpp>
+#include <Core/filesystem/pak_file_system.hpp>
+#include <Core/garbage_collector.hpp>
+#include <Core/memory_tracker.hpp>
+#include <Core/reflection/class.hpp>
 #include <Core/reflection/enum.hpp>
 #include <Core/string_functions.hpp>
+#include <Core/threading.hpp>
 #include <Core/types/path.hpp>
 #include <cctype>
 #include <cstdlib>
@@ -1895,6 +1901,132 @@ namespace Trinex::Console
 		return Strings::format("Removed alias '{}'", name);
 	}
 
+	trinex_static_console_command(console_task_stats, .name = "task_stats",
+	                              .description = "Show TaskGraph worker statistics: executed and stolen tasks, busy/idle time",
+	                              .usage       = "task_stats([reset=false])")
+	{
+		bool reset = false;
+		StringView flag;
+
+		if (frame->read_argument(flag))
+			Detail::parse_boolean(flag, reset);
+
+		TaskGraph* graph = TaskGraph::instance();
+		const u32 count  = graph->workers();
+
+		static auto milliseconds = [](u64 time) { return static_cast<f64>(time) / 1000000.0; };
+
+		Vector<String> lines;
+		lines.reserve(count + 2);
+		lines.push_back("  worker | executed | stolen | busy ms | idle ms | busy % | queue high-water");
+
+		TaskGraph::WorkerStats total;
+
+		for (u32 index = 0; index <= count; ++index)
+		{
+			TaskGraph::WorkerStats stats = graph->worker_stats(index);
+
+			const u64 active = stats.busy_time + stats.idle_time;
+			const f64 busy   = active ? 100.0 * static_cast<f64>(stats.busy_time) / static_cast<f64>(active) : 0.0;
+			String name      = index < count ? Strings::format("{}", index) : String("external");
+
+			lines.push_back(Strings::format("{:>8} | {:>8} | {:>6} | {:>7.1f} | {:>7.1f} | {:>5.1f}% | {}", name, stats.executed,
+			                                stats.stolen, milliseconds(stats.busy_time), milliseconds(stats.idle_time), busy,
+			                                stats.queue_depth));
+
+			total.executed += stats.executed;
+			total.stolen += stats.stolen;
+			total.busy_time += stats.busy_time;
+		}
+
+		lines.push_back(Strings::format("total: {} tasks, {} stolen, {:.1f} ms busy, {:.3f} ms waiting on full injection queue",
+		                                total.executed, total.stolen, milliseconds(total.busy_time),
+		                                milliseconds(graph->worker_stats(count).wait_time)));
+
+		if (reset)
+			graph->reset_stats();
+
+		return Strings::join(lines, "\n");
+	}
+
+	trinex_static_console_command(console_memreport, .name = "memreport",
+	                              .description = "Show memory usage and allocation counts of every subsystem and object pool",
+	                              .usage       = "memreport()")
+	{
+		static auto kilobytes = [](usize bytes) { return static_cast<f64>(bytes) / 1024.0; };
+
+		ByteAllocator::Statistics heap = ByteAllocator::statistics();
+
+		Vector<String> lines;
+		lines.push_back(Strings::format("ByteAllocator [{}]: {} arenas, {:.1f} KiB used of {:.1f} KiB reserved, "
+		                                "{} cache hits, {} cache misses, {} system allocations",
+		                                ByteAllocator::backend(), heap.arenas, kilobytes(heap.used_bytes),
+		                                kilobytes(heap.reserved_bytes), heap.cache_hits, heap.cache_misses,
+		                                heap.system_allocations));
+
+		lines.push_back("     tag | allocs/frame | KiB/frame | allocations |   total KiB | temp allocs |  live KiB |  peak KiB");
+
+		for (usize index = 0; index < static_cast<usize>(MemoryTag::Count); ++index)
+		{
+			const MemoryTag tag        = static_cast<MemoryTag>(index);
+			MemoryTracker::Stats stats = MemoryTracker::stats(tag);
+			const bool live            = MemoryTracker::is_live_tracking_enabled();
+			const String live_bytes    = live ? Strings::format("{:.1f}", kilobytes(stats.live_bytes)) : String("-");
+			const String peak_bytes    = live ? Strings::format("{:.1f}", kilobytes(stats.peak_bytes)) : String("-");
+
+			lines.push_back(Strings::format("{:>8} | {:>12} | {:>9.1f} | {:>11} | {:>11.1f} | {:>11} | {:>9} | {:>9}",
+			                                MemoryTracker::tag_name(tag), stats.frame_allocations,
+			                                kilobytes(stats.frame_bytes), stats.allocations, kilobytes(stats.allocated_bytes),
+			                                stats.temp_allocations, live_bytes, peak_bytes));
+		}
+
+		if (!MemoryTracker::is_live_tracking_enabled())
+			lines.push_back("Live and peak usage requires a build with TRINEX_WITH_MEMORY_TRACKING");
+
+		if (!Refl::Class::pooled_classes().empty())
+		{
+			lines.push_back("Object pools:");
+
+			for (Refl::Class* self : Refl::Class::pooled_classes())
+			{
+				Refl::Class::PoolStatistics pool = self->pool_statistics();
+				lines.push_back(Strings::format("    {}: {} live, {} peak, {} allocations, "
+				                                "{} slabs of {} byte slots, {:.1f} KiB reserved",
+				                                self->full_name(), pool.live_objects, pool.peak_objects, pool.allocations,
+				                                pool.slabs, pool.slot_size, kilobytes(pool.reserved_bytes)));
+			}
+		}
+
+		return Strings::join(lines, "\n");
+	}
+
+	trinex_static_console_command(console_gc_collect, .name = "gc_collect",
+	                              .description = "Run a full garbage collection cycle and show its statistics",
+	                              .usage       = "gc_collect()")
+	{
+		GarbageCollector::collect();
+		GarbageCollector::Statistics stats = GarbageCollector::statistics();
+
+		return Strings::format("GC cycle {}: {} objects marked, {} destroyed in {:.3f} ms, {} destroyed total", stats.cycles,
+		                       stats.marked_objects, stats.destroyed, stats.cycle_time, stats.total_destroyed);
+	}
+
+	trinex_static_console_command(console_pak_cook, .name = "pak_cook",
+	                              .description = "Pack all files of the directory into a package archive",
+	                              .usage       = "pak_cook(<directory>, <archive>)")
+	{
+		StringView directory;
+		StringView archive;
+
+		if (!frame->read_argument(directory) || !frame->read_argument(archive))
+			return frame->fail(ExecuteStatus::MissingRequiredParameter, "Usage: pak_cook(<directory>, <archive>)");
+
+		if (!VFS::PakFileSystem::cook(directory, archive))
+			return frame->fail(ExecuteStatus::CommandFailed, Strings::format("Failed to cook '{}' to '{}'", directory, archive));
+
+		return Strings::format("Cooked '{}' to '{}'", directory, archive);
+	}
+
 	trinex_static_console_command(console_aliases, .name = "aliases", .description = "List aliases", .usage = "aliases()")
 	{
 		if (ConsoleState::instance().aliases.empty())
@@ -0,0 +1,47 @@
+#include <Core/coroutine.hpp>
+#include <Core/etl/critical_section.hpp>
+#include <Core/etl/vector.hpp>
+#include <Core/tickable.hpp>
+
+namespace Trinex::Detail
+{
+	// Polling tasks are delayed until the next frame. Submitting them immediately would make the worker pop the same task
+	// from its own queue again and again, spinning instead of executing other tasks
+	static class : public Tickable
+	{
+	private:
+		CriticalSection m_critical_section;
+		Vector<Task> m_pending;
+		Vector<Task> m_submitting;
+
+	public:
+		void add_task(Task&& task)
+		{
+			ScopeLock lock(m_critical_section);
+			m_pending.push_back(etl::move(task));
+		}
+
+		Tickable& begin_frame(u64 frame) override
+		{
+			{
+				ScopeLock lock(m_critical_section);
+				m_pending.swap(m_submitting);
+			}
+
+			TaskGraph* graph = TaskGraph::instance();
+
+			for (Task& task : m_submitting)
+			{
+				graph->add_task(task);
+			}
+
+			m_submitting.clear();
+			return *this;
+		}
+	} s_next_frame_tasks;
+
+	ENGINE_EXPORT void add_task_next_frame(Task&& task)
+	{
+		s_next_frame_tasks.add_task(etl::move(task));
+	}
+}// namespace Trinex::Detail
@@ -69,6 +69,9 @@ namespace Trinex
 	static T* load_object(const char* name)
 	{
 		Object* obj = Object::load_object(name);
+
+		if (obj)
+			obj->flags |= Object::Flags::StandAlone;
 		return reinterpret_cast<T*>(obj);
 	}
 
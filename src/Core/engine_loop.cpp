@@ -8,6 +8,7 @@
 #include <Core/filesystem/root_filesystem.hpp>
 #include <Core/garbage_collector.hpp>
 #include <Core/library.hpp>
+#include <Core/pointer.hpp>
 #include <Core/reflection/class.hpp>
 #include <Core/reflection/struct.hpp>
 #include <Core/string_functions.hpp>
@@ -59,8 +60,8 @@ namespace Trinex
 	{
 		initialize_graphics_api(true);
 
-		i32 result        = 0;
-		EntryPoint* entry = Object::instance_cast<EntryPoint>(Refl::Class::static_require(entry_name)->create_object());
+		i32 result                = 0;
+		Pointer<EntryPoint> entry = Object::instance_cast<EntryPoint>(Refl::Class::static_require(entry_name)->create_object());
 		trinex_verify_msg(entry, "Failed to create entry point!");
 
 		Settings::Rendering::force_keep_cpu_resources = true;
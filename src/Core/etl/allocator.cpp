@@ -1,12 +1,18 @@
 #include <Core/base_engine.hpp>
 #include <Core/etl/allocator.hpp>
+#include <Core/etl/atomic.hpp>
 #include <Core/etl/critical_section.hpp>
 #include <Core/etl/pair.hpp>
 #include <Core/etl/vector.hpp>
 #include <Core/math/math.hpp>
 #include <Core/memory.hpp>
+#include <Core/memory_tracker.hpp>
 #include <Core/threading.hpp>
+#include <Engine/settings.hpp>
+#include <bit>
 #include <cstdlib>
+#include <cstring>
+#include <tlfs/tlsf.hpp>
 
 namespace Trinex
 {
@@ -130,33 +136,572 @@ namespace Trinex
 			}
 		};
 
+		static Atomic<u64> s_frame_index = 0;
+
+		// Ring of per-frame block chains, owned by a single thread. Slots are recycled lazily by the owning thread,
+		// when it allocates for the first time in a new frame, so reset never touches memory of other threads.
+		// Every slot remembers its frame, so the number of frames in flight may change at runtime
+		struct FrameAllocatorData {
+			using size_type                           = FrameByteAllocator::size_type;
+			static constexpr size_type min_block_size = 1024 * 64;
+			static constexpr u32 frames               = FrameByteAllocator::max_frames_in_flight;
+
+			struct Block {
+				Block* m_next;
+				u8* m_end;
+
+				inline u8* begin() { return reinterpret_cast<u8*>(this) + align_up(sizeof(Block), 16); }
+			};
+
+			struct Frame {
+				Block* m_head    = nullptr;
+				Block* m_current = nullptr;
+				u8* m_stack      = nullptr;
+				u64 m_frame      = 0;// Last frame that used the slot plus one, zero if the slot was never used
+			};
+
+			Frame m_frames[frames];
+			Frame* m_slot = nullptr;
+			u64 m_frame   = 0;
+
+			inline Frame& current_frame()
+			{
+				const u64 frame = s_frame_index.load(etl::memory_order_relaxed);
+
+				if (m_slot && frame == m_frame)
+					return *m_slot;
+
+				// At most frames_in_flight - 1 slots are still in flight, so a retired slot always exists.
+				// Slots which already own blocks are preferred, so steady state frames don't allocate new blocks
+				const u64 in_flight = FrameByteAllocator::frames_in_flight();
+				Frame* slot         = nullptr;
+
+				for (Frame& candidate : m_frames)
+				{
+					if (candidate.m_frame != 0 && candidate.m_frame - 1 + in_flight > frame)
+						continue;
+
+					if (slot == nullptr || (slot->m_head == nullptr && candidate.m_head != nullptr))
+						slot = &candidate;
+				}
+
+				slot->m_frame   = frame + 1;
+				slot->m_current = slot->m_head;
+				slot->m_stack   = slot->m_head ? slot->m_head->begin() : nullptr;
+
+				m_slot  = slot;
+				m_frame = frame;
+				return *slot;
+			}
+
+			static Block* allocate_block(size_type size, size_type align)
+			{
+				const size_type header = align_up(sizeof(Block), 16);
+				size                   = Math::max(size + header + align, min_block_size);
+
+				Block* block  = reinterpret_cast<Block*>(ByteAllocator::allocate_aligned(size, 16));
+				block->m_next = nullptr;
+				block->m_end  = reinterpret_cast<u8*>(block) + size;
+				return block;
+			}
+
+			inline u8* allocate_aligned(size_type size, size_type align)
+			{
+				Frame& frame = current_frame();
+
+				while (frame.m_current)
+				{
+					u8* ptr = align_memory(frame.m_stack, align);
+
+					if (ptr + size <= frame.m_current->m_end)
+					{
+						frame.m_stack = ptr + size;
+						return ptr;
+					}
+
+					if (frame.m_current->m_next == nullptr)
+						break;
+
+					frame.m_current = frame.m_current->m_next;
+					frame.m_stack   = frame.m_current->begin();
+				}
+
+				Block* block = allocate_block(size, align);
+
+				if (frame.m_current)
+					frame.m_current->m_next = block;
+				else
+					frame.m_head = block;
+
+				frame.m_current = block;
+				u8* ptr         = align_memory(block->begin(), align);
+				frame.m_stack   = ptr + size;
+				return ptr;
+			}
+
+			~FrameAllocatorData()
+			{
+				for (Frame& frame : m_frames)
+				{
+					while (Block* block = frame.m_head)
+					{
+						frame.m_head = block->m_next;
+						ByteAllocator::deallocate(reinterpret_cast<u8*>(block));
+					}
+				}
+			}
+		};
+
 		static TempAllocatorSync s_stack_sync;
-		static TempAllocatorSync s_frame_sync;
 
 		static thread_local TempAllocatorData s_stack_allocator(&s_stack_sync);
-		static thread_local TempAllocatorData s_frame_allocator(&s_frame_sync);
+		static thread_local FrameAllocatorData s_frame_allocator;
 	}// namespace
 
-	unsigned char* ByteAllocator::allocate_aligned(size_type size, size_type align)
+	namespace
 	{
-		size = align_up(size, align);
+		inline u8* system_allocate(usize size, usize align)
+		{
+			size = align_up(size, align);
+
+#if PLATFORM_WINDOWS
+			return static_cast<u8*>(_aligned_malloc(size, align));
+#else
+			return static_cast<u8*>(std::aligned_alloc(align, size));
+#endif
+		}
 
+		inline void system_deallocate(void* ptr)
+		{
 #if PLATFORM_WINDOWS
-		return static_cast<unsigned char*>(_aligned_malloc(size, align));
+			_aligned_free(ptr);
 #else
-		return static_cast<unsigned char*>(std::aligned_alloc(align, size));
+			std::free(ptr);
+#endif
+		}
+
+		// General purpose heap: thread-local size class caches in front of TLSF arenas, which are guarded by a single lock.
+		// Large allocations go directly to the system allocator. The system allocator is also used for everything when
+		// the TRINEX_ALLOCATOR environment variable is set to "system", which is useful for memory debugging tools.
+		class GeneralHeap
+		{
+		public:
+			static constexpr usize s_arena_size       = 64 * 1024 * 1024;
+			static constexpr usize s_max_arenas       = 256;
+			static constexpr usize s_max_arena_alloc  = 1024 * 1024;
+			static constexpr usize s_min_alignment    = 16;
+			static constexpr usize s_class_count      = 28;
+			static constexpr usize s_max_class_size   = 4096;
+			static constexpr usize s_class_cache_size = 32 * 1024;
+
+			// Open addressing table of arena base addresses, kept at most half full. Arenas are never released, so
+			// entries are only inserted and lookups don't need the lock
+			static constexpr usize s_arena_table_bits = 9;
+			static constexpr usize s_arena_table_size = usize(1) << s_arena_table_bits;
+			static_assert(s_arena_table_size >= s_max_arenas * 2);
+
+			static constexpr usize s_class_sizes[s_class_count] = {
+			        16,  32,  48,  64,  80,  96,  112, 128, 160, 192, 224, 256, 320, 384,
+			        448, 512, 640, 768, 896, 1024, 1280, 1536, 1792, 2048, 2560, 3072, 3584, 4096,
+			};
+
+			struct Arena {
+				tlsf::Allocator tlsf;
+			};
+
+			struct ThreadCache {
+				struct FreeBlock {
+					FreeBlock* next;
+				};
+
+				FreeBlock* blocks[s_class_count] = {};
+				u32 count[s_class_count]         = {};
+				Atomic<u64> hits                 = 0;
+				Atomic<u64> misses               = 0;
+				ThreadCache* next                = nullptr;
+				ThreadCache* prev                = nullptr;
+			};
+
+		private:
+			CriticalSection m_cs;
+			Atomic<Arena*> m_arenas[s_max_arenas]            = {};
+			Atomic<Arena*> m_arena_table[s_arena_table_size] = {};
+			Atomic<usize> m_arena_count                      = 0;
+			usize m_current                                  = 0;
+			usize m_used_bytes                               = 0;
+			ThreadCache* m_caches                            = nullptr;
+			u64 m_released_hits                              = 0;
+			u64 m_released_misses                            = 0;
+			Atomic<u64> m_system_allocations                 = 0;
+			bool m_enabled                                   = true;
+
+			static inline void increment(Atomic<u64>& counter)
+			{
+				counter.store(counter.load(etl::memory_order_relaxed) + 1, etl::memory_order_relaxed);
+			}
+
+			Arena* create_arena()
+			{
+				const usize index = m_arena_count.load(etl::memory_order_relaxed);
+
+				if (index >= s_max_arenas)
+					return nullptr;
+
+				u8* memory = system_allocate(s_arena_size, s_arena_size);
+
+				if (memory == nullptr)
+					return nullptr;
+
+				const usize header = align_up(sizeof(Arena), 64);
+				Arena* arena       = new (memory) Arena();
+				arena->tlsf.init(memory + header, s_arena_size - header);
+
+				usize slot = arena_slot(memory);
+
+				while (m_arena_table[slot].load(etl::memory_order_relaxed)) slot = (slot + 1) % s_arena_table_size;
+
+				m_arena_table[slot].store(arena, etl::memory_order_release);
+				m_arenas[index].store(arena, etl::memory_order_relaxed);
+				m_arena_count.store(index + 1, etl::memory_order_release);
+				return arena;
+			}
+
+			static inline usize arena_slot(const void* base)
+			{
+				const u64 key = static_cast<u64>(reinterpret_cast<usize>(base) / s_arena_size);
+				return static_cast<usize>((key * 0x9E3779B97F4A7C15ULL) >> (64 - s_arena_table_bits));
+			}
+
+			void* allocate_locked(usize size, usize align)
+			{
+				const usize count = m_arena_count.load(etl::memory_order_relaxed);
+
+				for (usize i = 0; i < count; ++i)
+				{
+					const usize index = (m_current + i) % count;
+
+					if (void* ptr = m_arenas[index].load(etl::memory_order_relaxed)->tlsf.alloc(size, align))
+					{
+						m_current = index;
+						m_used_bytes += tlsf::Allocator::usable_size(ptr);
+						return ptr;
+					}
+				}
+
+				if (Arena* arena = create_arena())
+				{
+					if (void* ptr = arena->tlsf.alloc(size, align))
+					{
+						m_current = count;
+						m_used_bytes += tlsf::Allocator::usable_size(ptr);
+						return ptr;
+					}
+				}
+
+				return nullptr;
+			}
+
+			void deallocate_locked(void* ptr)
+			{
+				m_used_bytes -= tlsf::Allocator::usable_size(ptr);
+				find_arena(ptr)->tlsf.free(ptr);
+			}
+
+			Arena* find_arena(const void* ptr) const
+			{
+				const usize base = align_down(reinterpret_cast<usize>(ptr), s_arena_size);
+
+				for (usize slot = arena_slot(reinterpret_cast<const void*>(base));; slot = (slot + 1) % s_arena_table_size)
+				{
+					Arena* arena = m_arena_table[slot].load(etl::memory_order_acquire);
+
+					if (arena == nullptr || reinterpret_cast<usize>(arena) == base)
+						return arena;
+				}
+			}
+
+			static inline usize class_index(usize size)
+			{
+				if (size <= 128)
+					return size == 0 ? 0 : (size - 1) >> 4;
+
+				// Four classes per power of two above 128 bytes
+				const usize log = 63 - std::countl_zero(static_cast<u64>(size - 1));
+				return 8 + (log - 7) * 4 + ((size - 1 - (usize(1) << log)) >> (log - 2));
+			}
+
+			static inline u32 class_limit(usize index)
+			{
+				return Math::clamp<u32>(s_class_cache_size / s_class_sizes[index], 4, 256);
+			}
+
+			void flush(ThreadCache* cache, usize index, u32 count)
+			{
+				ScopeLock lock(m_cs);
+
+				while (count-- > 0 && cache->blocks[index])
+				{
+					ThreadCache::FreeBlock* block = cache->blocks[index];
+					cache->blocks[index]          = block->next;
+					--cache->count[index];
+					deallocate_locked(block);
+				}
+			}
+
+			void* refill(ThreadCache* cache, usize index)
+			{
+				const usize size = s_class_sizes[index];
+				const u32 count  = class_limit(index) / 2;
+
+				ScopeLock lock(m_cs);
+				void* result = allocate_locked(size, s_min_alignment);
+
+				if (result == nullptr)
+					return nullptr;
+
+				for (u32 i = 1; i < count; ++i)
+				{
+					auto* block = static_cast<ThreadCache::FreeBlock*>(allocate_locked(size, s_min_alignment));
+
+					if (block == nullptr)
+						break;
+
+					block->next          = cache->blocks[index];
+					cache->blocks[index] = block;
+					++cache->count[index];
+				}
+
+				return result;
+			}
+
+		public:
+			GeneralHeap()
+			{
+				if (const char* backend = std::getenv("TRINEX_ALLOCATOR"))
+				{
+					m_enabled = std::strcmp(backend, "system") != 0;
+				}
+			}
+
+			inline bool is_enabled() const { return m_enabled; }
+			inline bool owns(const void* ptr) const { return find_arena(ptr) != nullptr; }
+
+			inline void* allocate(ThreadCache* cache, usize size, usize align)
+			{
+				if (cache && size <= s_max_class_size && align <= s_min_alignment)
+				{
+					const usize index = class_index(size);
+
+					if (ThreadCache::FreeBlock* block = cache->blocks[index])
+					{
+						cache->blocks[index] = block->next;
+						--cache->count[index];
+						increment(cache->hits);
+						return block;
+					}
+
+					increment(cache->misses);
+					return refill(cache, index);
+				}
+
+				ScopeLock lock(m_cs);
+				return allocate_locked(size, Math::max(align, s_min_alignment));
+			}
+
+			inline void deallocate(ThreadCache* cache, void* ptr)
+			{
+				const usize size = tlsf::Allocator::usable_size(ptr);
+
+				// Blocks of the biggest class may be slightly larger than the class size. Blocks smaller than the smallest
+				// class can only come from aligned allocations, they can't serve any class and go back to the arena
+				if (cache && size >= s_class_sizes[0] && size <= s_max_class_size + s_max_class_size / 4)
+				{
+					usize index = class_index(Math::min(size, s_max_class_size));
+
+					if (s_class_sizes[index] > size)
+						--index;
+
+					auto* block          = static_cast<ThreadCache::FreeBlock*>(ptr);
+					block->next          = cache->blocks[index];
+					cache->blocks[index] = block;
+
+					const u32 limit = class_limit(index);
+
+					if (++cache->count[index] > limit)
+						flush(cache, index, limit / 2);
+					return;
+				}
+
+				ScopeLock lock(m_cs);
+				deallocate_locked(ptr);
+			}
+
+			void register_cache(ThreadCache* cache)
+			{
+				ScopeLock lock(m_cs);
+				cache->next = m_caches;
+
+				if (m_caches)
+					m_caches->prev = cache;
+
+				m_caches = cache;
+			}
+
+			void unregister_cache(ThreadCache* cache)
+			{
+				for (usize index = 0; index < s_class_count; ++index) flush(cache, index, cache->count[index]);
+
+				ScopeLock lock(m_cs);
+
+				if (cache->prev)
+					cache->prev->next = cache->next;
+				else
+					m_caches = cache->next;
+
+				if (cache->next)
+					cache->next->prev = cache->prev;
+
+				m_released_hits += cache->hits.load(etl::memory_order_relaxed);
+				m_released_misses += cache->misses.load(etl::memory_order_relaxed);
+			}
+
+			inline void on_system_allocation() { m_system_allocations.fetch_add(1, etl::memory_order_relaxed); }
+
+			ByteAllocator::Statistics statistics()
+			{
+				ScopeLock lock(m_cs);
+
+				ByteAllocator::Statistics stats;
+				stats.arenas             = m_arena_count.load(etl::memory_order_relaxed);
+				stats.reserved_bytes     = stats.arenas * s_arena_size;
+				stats.used_bytes         = m_used_bytes;
+				stats.cache_hits         = m_released_hits;
+				stats.cache_misses       = m_released_misses;
+				stats.system_allocations = m_system_allocations.load(etl::memory_order_relaxed);
+
+				for (ThreadCache* cache = m_caches; cache; cache = cache->next)
+				{
+					stats.cache_hits += cache->hits.load(etl::memory_order_relaxed);
+					stats.cache_misses += cache->misses.load(etl::memory_order_relaxed);
+				}
+
+				return stats;
+			}
+		};
+
+		// Heap is never destroyed, memory may be released by static destructors after the end of main
+		static GeneralHeap& general_heap()
+		{
+			alignas(GeneralHeap) static u8 storage[sizeof(GeneralHeap)];
+			static GeneralHeap* heap = new (storage) GeneralHeap();
+			return *heap;
+		}
+
+		static thread_local GeneralHeap::ThreadCache* s_thread_cache = nullptr;
+		static thread_local bool s_thread_cache_released             = false;
+
+		struct ThreadCacheOwner {
+			GeneralHeap::ThreadCache cache;
+
+			ThreadCacheOwner() { general_heap().register_cache(&cache); }
+
+			~ThreadCacheOwner()
+			{
+				s_thread_cache          = nullptr;
+				s_thread_cache_released = true;
+				general_heap().unregister_cache(&cache);
+			}
+		};
+
+		// Returns nullptr after the thread cache was destroyed, blocks are passed directly to the arenas after that point
+		static inline GeneralHeap::ThreadCache* thread_cache()
+		{
+			if (s_thread_cache || s_thread_cache_released)
+				return s_thread_cache;
+
+			static thread_local ThreadCacheOwner owner;
+			s_thread_cache = &owner.cache;
+			return s_thread_cache;
+		}
+
+		static u8* allocate_memory(usize size, usize align)
+		{
+			GeneralHeap& heap = general_heap();
+
+			if (heap.is_enabled() && size <= GeneralHeap::s_max_arena_alloc)
+			{
+				if (void* ptr = heap.allocate(thread_cache(), size, align))
+					return static_cast<u8*>(ptr);
+			}
+
+			heap.on_system_allocation();
+			return system_allocate(size, align);
+		}
+
+		static void deallocate_memory(u8* ptr)
+		{
+			GeneralHeap& heap = general_heap();
+
+			if (heap.owns(ptr))
+				heap.deallocate(thread_cache(), ptr);
+			else
+				system_deallocate(ptr);
+		}
+
+#if TRINEX_WITH_MEMORY_TRACKING
+		// Stored right before every tracked allocation
+		struct alignas(16) AllocationHeader {
+			usize size;
+			u32 offset;
+			MemoryTag tag;
+		};
+#endif
+	}// namespace
+
+	unsigned char* ByteAllocator::allocate_aligned(size_type size, size_type align)
+	{
+		MemoryTracker::on_allocate(size);
+
+#if TRINEX_WITH_MEMORY_TRACKING
+		const usize offset = Math::max<usize>(align, sizeof(AllocationHeader));
+		u8* memory         = allocate_memory(size + offset, Math::max<usize>(align, alignof(AllocationHeader)));
+		auto header        = reinterpret_cast<AllocationHeader*>(memory + offset) - 1;
+
+		header->size   = size;
+		header->offset = static_cast<u32>(offset);
+		header->tag    = MemoryTracker::tag();
+
+		MemoryTracker::on_live_allocate(header->tag, size);
+		return memory + offset;
+#else
+		return allocate_memory(size, align);
 #endif
 	}
 
 	void ByteAllocator::deallocate(unsigned char* ptr) noexcept
 	{
-#if PLATFORM_WINDOWS
-		_aligned_free(ptr);
+		if (ptr == nullptr)
+			return;
+
+#if TRINEX_WITH_MEMORY_TRACKING
+		auto header = reinterpret_cast<AllocationHeader*>(ptr) - 1;
+		MemoryTracker::on_live_deallocate(header->tag, header->size);
+		deallocate_memory(ptr - header->offset);
 #else
-		std::free(ptr);
+		deallocate_memory(ptr);
 #endif
 	}
 
+	ByteAllocator::Statistics ByteAllocator::statistics()
+	{
+		return general_heap().statistics();
+	}
+
+	const char* ByteAllocator::backend()
+	{
+		return general_heap().is_enabled() ? "tlsf" : "system";
+	}
+
 	StackByteAllocator::Mark::Mark() : m_location(StackByteAllocator::location()) {}
 
 	StackByteAllocator::Mark& StackByteAllocator::Mark::reset()
@@ -172,6 +717,7 @@ namespace Trinex
 
 	unsigned char* StackByteAllocator::allocate_aligned(size_type size, size_type align)
 	{
+		MemoryTracker::on_temp_allocate(size);
 		return s_stack_allocator.allocate_aligned(size, align);
 	}
 
@@ -208,11 +754,22 @@ namespace Trinex
 
 	unsigned char* FrameByteAllocator::allocate_aligned(size_type size, size_type align)
 	{
+		MemoryTracker::on_temp_allocate(size);
 		return s_frame_allocator.allocate_aligned(size, align);
 	}
 
 	void FrameByteAllocator::reset()
 	{
-		reset_stack_allocator(&s_frame_sync);
+		s_frame_index.fetch_add(1, etl::memory_order_relaxed);
+	}
+
+	u64 FrameByteAllocator::frame_index()
+	{
+		return s_frame_index.load(etl::memory_order_relaxed);
+	}
+
+	u32 FrameByteAllocator::frames_in_flight()
+	{
+		return Math::clamp<u32>(Settings::Rendering::frames_in_flight, 1, max_frames_in_flight);
 	}
 }// namespace Trinex
@@ -2,32 +2,79 @@
 #include <Core/object.hpp>
 #include <Core/reflection/class.hpp>
 #include <Core/string_functions.hpp>
-#include <algorithm>
 
 namespace Trinex
 {
-	static bool predicate(const Object* object, Identifier id)
+	static inline bool is_indexed(const Map<u32, Object*>& objects)
 	{
-		return object->name().index() < id;
+		return !objects.empty();
 	}
 
-	bool ObjectTreeNodeStatics::lower_bound(iterator begin, iterator end, iterator& out, Object* object, Refl::Class* check_class)
+	bool ObjectTreeNodeStatics::is_element(Object* object, Refl::Class* check_class)
 	{
-		if (!object->class_instance()->is_a(check_class))
+		return object->class_instance()->is_a(check_class);
+	}
+
+	void ObjectTreeNodeStatics::add(ChildIndex& index, const_iterator begin, const_iterator end, Object* child)
+	{
+		if (!is_indexed(index.objects))
+		{
+			if (static_cast<usize>(end - begin) < index_threshold)
+				return;
+
+			index.objects.reserve(end - begin);
+
+			for (const_iterator it = begin; it != end; ++it)
+			{
+				if (!index.objects.insert({(*it)->name().index(), *it}).second)
+					++index.collisions;
+			}
+			return;
+		}
+
+		if (!index.objects.insert({child->name().index(), child}).second)
+			++index.collisions;
+	}
+
+	void ObjectTreeNodeStatics::remove(ChildIndex& index, const_iterator begin, const_iterator end, Object* child)
+	{
+		if (!is_indexed(index.objects))
+			return;
+
+		const u32 id = child->name().index();
+		auto it      = index.objects.find(id);
+
+		if (it == index.objects.end())
+			return;
+
+		if (it->second != child)
 		{
-			return false;
+			// Removed child was hidden by another child with the same name
+			--index.collisions;
+			return;
 		}
 
-		Identifier id = object->name().index();
-		out           = std::lower_bound(begin, end, id, predicate);
-		return true;
+		index.objects.erase(it);
+
+		if (index.collisions == 0)
+			return;
+
+		for (const_iterator current = begin; current != end; ++current)
+		{
+			if ((*current)->name().index() == id)
+			{
+				index.objects.insert({id, *current});
+				--index.collisions;
+				return;
+			}
+		}
 	}
 
-	Object* ObjectTreeNodeStatics::find(const_iterator begin, const_iterator end, StringView full_name)
+	Object* ObjectTreeNodeStatics::find(const ChildIndex& index, const_iterator begin, const_iterator end, StringView full_name)
 	{
 		Name name = Strings::parse_name_identifier(full_name, &full_name);
 
-		if (auto child = find(begin, end, name))
+		if (auto child = find(index, begin, end, name))
 		{
 			if (!full_name.empty())
 			{
@@ -38,16 +85,22 @@ namespace Trinex
 		return nullptr;
 	}
 
-	Object* ObjectTreeNodeStatics::find(const_iterator begin, const_iterator end, Name name)
+	Object* ObjectTreeNodeStatics::find(const ChildIndex& index, const_iterator begin, const_iterator end, Name name)
 	{
-		Identifier id = name.index();
-		auto place    = std::lower_bound(begin, end, id, predicate);
+		const u32 id = name.index();
+
+		if (is_indexed(index.objects))
+		{
+			auto it = index.objects.find(id);
+			return it != index.objects.end() ? it->second : nullptr;
+		}
 
-		if (place != end)
+		for (const_iterator it = begin; it != end; ++it)
 		{
-			if ((*place)->name() == name)
-				return *place;
+			if ((*it)->name().index() == id)
+				return *it;
 		}
+
 		return nullptr;
 	}
 }// namespace Trinex
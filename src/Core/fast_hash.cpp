@@ -0,0 +1,389 @@
+#include <Core/memory.hpp>
+#include <bit>
+
+#if ARCH_X86_64
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace Trinex
+{
+	// Striped hash in the spirit of XXH3. Long inputs are split into 64 byte stripes which are accumulated into 8 independent
+	// 64 bit lanes, so the accumulation maps directly onto SSE2, AVX2 and NEON registers. Every implementation produces the same
+	// result, the instruction set is selected at runtime.
+	//
+	// Changing any constant or step below changes the hash values, increase memory_hash_fast_version in that case!
+
+	static_assert(std::endian::native == std::endian::little, "memory_hash_fast expects little endian byte order");
+	static_assert(memory_hash_fast_version == 1, "Hash implementation doesn't match memory_hash_fast_version");
+
+	namespace
+	{
+		static constexpr u64 s_prime32_1 = 0x9E3779B1U;
+		static constexpr u64 s_prime32_2 = 0x85EBCA77U;
+		static constexpr u64 s_prime32_3 = 0xC2B2AE3DU;
+		static constexpr u64 s_prime64_1 = 0x9E3779B185EBCA87ULL;
+		static constexpr u64 s_prime64_2 = 0xC2B2AE3D27D4EB4FULL;
+		static constexpr u64 s_prime64_3 = 0x165667B19E3779F9ULL;
+		static constexpr u64 s_prime64_4 = 0x85EBCA77C2B2AE63ULL;
+		static constexpr u64 s_prime64_5 = 0x27D4EB2F165667C5ULL;
+
+		static constexpr usize s_stripe_size       = 64;
+		static constexpr usize s_stripes_per_block = 16;
+		static constexpr usize s_block_size        = s_stripe_size * s_stripes_per_block;
+		static constexpr usize s_medium_threshold  = 16;
+		static constexpr usize s_long_threshold    = 240;
+
+		// Stripe j of a block is keyed by secret[j .. j + 7], so the secret must have s_stripes_per_block + 8 words
+		struct Secret {
+			u64 values[s_stripes_per_block + 8];
+		};
+
+		static constexpr Secret make_secret()
+		{
+			Secret secret = {};
+			u64 state     = 0x9E3779B97F4A7C15ULL;
+
+			for (u64& value : secret.values)
+			{
+				// splitmix64
+				u64 z = (state += 0x9E3779B97F4A7C15ULL);
+				z     = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+				z     = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+				value = z ^ (z >> 31);
+			}
+
+			return secret;
+		}
+
+		alignas(64) static constexpr Secret s_secret = make_secret();
+
+		static constexpr usize s_scramble_key = s_stripes_per_block;
+		static constexpr usize s_last_key     = 9;
+		static constexpr usize s_merge_lo_key = 3;
+		static constexpr usize s_merge_hi_key = 13;
+
+		static FORCE_INLINE u64 read64(const u8* data)
+		{
+			u64 result;
+			std::memcpy(&result, data, sizeof(result));
+			return result;
+		}
+
+		static FORCE_INLINE u64 read32(const u8* data)
+		{
+			u32 result;
+			std::memcpy(&result, data, sizeof(result));
+			return result;
+		}
+
+		static FORCE_INLINE u64 mul_fold(u64 a, u64 b)
+		{
+			const u128 product = static_cast<u128>(a) * b;
+			return static_cast<u64>(product) ^ static_cast<u64>(product >> 64);
+		}
+
+		static FORCE_INLINE u64 avalanche(u64 h)
+		{
+			h ^= h >> 37;
+			h *= s_prime64_3;
+			return h ^ (h >> 32);
+		}
+
+		static FORCE_INLINE u128 make_hash(u64 lo, u64 hi)
+		{
+			return (static_cast<u128>(hi) << 64) | lo;
+		}
+
+		using AccumulateFunction = void (*)(u64* acc, const u8* data, usize stripes, const u64* secret);
+		using ScrambleFunction   = void (*)(u64* acc, const u64* secret);
+
+		// Reference implementation, the SIMD versions must match it bit for bit
+		[[maybe_unused]] static void accumulate_scalar(u64* acc, const u8* data, usize stripes, const u64* secret)
+		{
+			for (usize stripe = 0; stripe < stripes; ++stripe, data += s_stripe_size, ++secret)
+			{
+				for (usize lane = 0; lane < 8; ++lane)
+				{
+					const u64 value = read64(data + lane * 8);
+					const u64 key   = value ^ secret[lane];
+
+					acc[lane ^ 1] += value;
+					acc[lane] += (key & 0xFFFFFFFF) * (key >> 32);
+				}
+			}
+		}
+
+		[[maybe_unused]] static void scramble_scalar(u64* acc, const u64* secret)
+		{
+			for (usize lane = 0; lane < 8; ++lane)
+			{
+				u64 value = acc[lane];
+				value ^= value >> 47;
+				value ^= secret[lane];
+				acc[lane] = value * s_prime32_1;
+			}
+		}
+
+#if ARCH_X86_64
+		static void accumulate_sse2(u64* acc, const u8* data, usize stripes, const u64* secret)
+		{
+			__m128i xacc[4];
+
+			for (usize i = 0; i < 4; ++i) xacc[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc) + i);
+
+			for (usize stripe = 0; stripe < stripes; ++stripe, data += s_stripe_size, ++secret)
+			{
+				for (usize i = 0; i < 4; ++i)
+				{
+					const __m128i value   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data) + i);
+					const __m128i secrets = _mm_loadu_si128(reinterpret_cast<const __m128i*>(secret) + i);
+					const __m128i key     = _mm_xor_si128(value, secrets);
+					const __m128i key_hi  = _mm_shuffle_epi32(key, _MM_SHUFFLE(0, 3, 0, 1));
+					const __m128i product = _mm_mul_epu32(key, key_hi);
+					const __m128i swapped = _mm_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2));
+					xacc[i]               = _mm_add_epi64(xacc[i], _mm_add_epi64(product, swapped));
+				}
+			}
+
+			for (usize i = 0; i < 4; ++i) _mm_storeu_si128(reinterpret_cast<__m128i*>(acc) + i, xacc[i]);
+		}
+
+		static void scramble_sse2(u64* acc, const u64* secret)
+		{
+			const __m128i prime = _mm_set1_epi32(static_cast<i32>(s_prime32_1));
+
+			for (usize i = 0; i < 4; ++i)
+			{
+				__m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc) + i);
+				value         = _mm_xor_si128(value, _mm_srli_epi64(value, 47));
+				value         = _mm_xor_si128(value, _mm_loadu_si128(reinterpret_cast<const __m128i*>(secret) + i));
+
+				const __m128i product_lo = _mm_mul_epu32(value, prime);
+				const __m128i product_hi = _mm_mul_epu32(_mm_shuffle_epi32(value, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+				value                    = _mm_add_epi64(product_lo, _mm_slli_epi64(product_hi, 32));
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(acc) + i, value);
+			}
+		}
+
+		__attribute__((target("avx2"))) static void accumulate_avx2(u64* acc, const u8* data, usize stripes, const u64* secret)
+		{
+			__m256i xacc[2];
+
+			for (usize i = 0; i < 2; ++i) xacc[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc) + i);
+
+			for (usize stripe = 0; stripe < stripes; ++stripe, data += s_stripe_size, ++secret)
+			{
+				for (usize i = 0; i < 2; ++i)
+				{
+					const __m256i value   = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data) + i);
+					const __m256i secrets = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(secret) + i);
+					const __m256i key     = _mm256_xor_si256(value, secrets);
+					const __m256i key_hi  = _mm256_shuffle_epi32(key, _MM_SHUFFLE(0, 3, 0, 1));
+					const __m256i product = _mm256_mul_epu32(key, key_hi);
+					const __m256i swapped = _mm256_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2));
+					xacc[i]               = _mm256_add_epi64(xacc[i], _mm256_add_epi64(product, swapped));
+				}
+			}
+
+			for (usize i = 0; i < 2; ++i) _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc) + i, xacc[i]);
+		}
+
+		__attribute__((target("avx2"))) static void scramble_avx2(u64* acc, const u64* secret)
+		{
+			const __m256i prime = _mm256_set1_epi32(static_cast<i32>(s_prime32_1));
+
+			for (usize i = 0; i < 2; ++i)
+			{
+				__m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc) + i);
+				value         = _mm256_xor_si256(value, _mm256_srli_epi64(value, 47));
+				value         = _mm256_xor_si256(value, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(secret) + i));
+
+				const __m256i product_lo = _mm256_mul_epu32(value, prime);
+				const __m256i product_hi = _mm256_mul_epu32(_mm256_shuffle_epi32(value, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+				value                    = _mm256_add_epi64(product_lo, _mm256_slli_epi64(product_hi, 32));
+
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(acc) + i, value);
+			}
+		}
+#elif defined(__ARM_NEON)
+		static void accumulate_neon(u64* acc, const u8* data, usize stripes, const u64* secret)
+		{
+			uint64x2_t xacc[4];
+
+			for (usize i = 0; i < 4; ++i) xacc[i] = vld1q_u64(acc + i * 2);
+
+			for (usize stripe = 0; stripe < stripes; ++stripe, data += s_stripe_size, ++secret)
+			{
+				for (usize i = 0; i < 4; ++i)
+				{
+					const uint64x2_t value = vreinterpretq_u64_u8(vld1q_u8(data + i * 16));
+					const uint64x2_t key   = veorq_u64(value, vld1q_u64(secret + i * 2));
+
+					xacc[i] = vaddq_u64(xacc[i], vextq_u64(value, value, 1));
+					xacc[i] = vmlal_u32(xacc[i], vmovn_u64(key), vshrn_n_u64(key, 32));
+				}
+			}
+
+			for (usize i = 0; i < 4; ++i) vst1q_u64(acc + i * 2, xacc[i]);
+		}
+
+		static void scramble_neon(u64* acc, const u64* secret)
+		{
+			const uint32x2_t prime = vdup_n_u32(static_cast<u32>(s_prime32_1));
+
+			for (usize i = 0; i < 4; ++i)
+			{
+				uint64x2_t value = vld1q_u64(acc + i * 2);
+				value            = veorq_u64(value, vshrq_n_u64(value, 47));
+				value            = veorq_u64(value, vld1q_u64(secret + i * 2));
+
+				const uint64x2_t product_hi = vshlq_n_u64(vmull_u32(vshrn_n_u64(value, 32), prime), 32);
+				vst1q_u64(acc + i * 2, vmlal_u32(product_hi, vmovn_u64(value), prime));
+			}
+		}
+#endif
+
+		struct HashBackend {
+			AccumulateFunction accumulate;
+			ScrambleFunction scramble;
+		};
+
+		static HashBackend select_hash_backend()
+		{
+#if ARCH_X86_64
+			if (__builtin_cpu_supports("avx2"))
+				return {accumulate_avx2, scramble_avx2};
+			return {accumulate_sse2, scramble_sse2};
+#elif defined(__ARM_NEON)
+			return {accumulate_neon, scramble_neon};
+#else
+			return {accumulate_scalar, scramble_scalar};
+#endif
+		}
+
+		// Function local static, because hashes can be requested during static initialization
+		static const HashBackend& hash_backend()
+		{
+			static const HashBackend backend = select_hash_backend();
+			return backend;
+		}
+
+		static FORCE_INLINE u128 hash_short(const u8* data, usize size, u64 seed_lo, u64 seed_hi)
+		{
+			u64 a;
+			u64 b;
+
+			if (size > 8)
+			{
+				a = read64(data);
+				b = read64(data + size - 8);
+			}
+			else if (size >= 4)
+			{
+				a = read32(data);
+				b = read32(data + size - 4);
+			}
+			else if (size > 0)
+			{
+				a = (static_cast<u64>(data[0]) << 16) | (static_cast<u64>(data[size >> 1]) << 8) | data[size - 1];
+				b = a;
+			}
+			else
+			{
+				a = 0;
+				b = 0;
+			}
+
+			const u64 lo = mul_fold(a ^ s_secret.values[0] ^ seed_lo, b ^ s_secret.values[1] ^ size);
+			const u64 hi = mul_fold(a ^ s_secret.values[2] ^ seed_hi, b ^ s_secret.values[3] ^ (size * s_prime64_1));
+			return make_hash(avalanche(lo ^ seed_hi), avalanche(hi + lo));
+		}
+
+		static FORCE_INLINE u128 hash_medium(const u8* data, usize size, u64 seed_lo, u64 seed_hi)
+		{
+			const u64* secret = s_secret.values;
+			const usize count = (size - 1) / 16;
+
+			u64 lo = (size * s_prime64_1) ^ seed_lo;
+			u64 hi = ~(size * s_prime64_2) ^ seed_hi;
+
+			// Rotations make every chunk contribution depend on its position
+			for (usize i = 0; i < count; ++i, data += 16)
+			{
+				const u64* key = secret + (i % 10) * 2;
+				const u64 a    = read64(data);
+				const u64 b    = read64(data + 8);
+
+				lo = std::rotl(lo, 27) + mul_fold(a ^ key[0], b ^ key[1]);
+				hi = std::rotl(hi, 31) + mul_fold(a ^ key[2], b ^ key[3] ^ seed_lo);
+			}
+
+			// Last 16 bytes, possibly overlapping with the last chunk
+			data         = data + (size - count * 16) - 16;
+			const u64 a  = read64(data);
+			const u64 b  = read64(data + 8);
+			lo           = std::rotl(lo, 27) + mul_fold(a ^ secret[20], b ^ secret[21]);
+			hi           = std::rotl(hi, 31) + mul_fold(a ^ secret[22], b ^ secret[23] ^ seed_lo);
+			const u64 rl = avalanche(lo + hi);
+			return make_hash(rl, avalanche(hi ^ (lo * s_prime64_4) ^ rl));
+		}
+
+		static FORCE_INLINE u64 merge_accumulators(const u64* acc, const u64* secret, u64 start)
+		{
+			u64 result = start;
+
+			for (usize i = 0; i < 4; ++i)
+			{
+				result += mul_fold(acc[i * 2] ^ secret[i * 2], acc[i * 2 + 1] ^ secret[i * 2 + 1]);
+			}
+
+			return avalanche(result);
+		}
+
+		static u128 hash_long(const u8* data, usize size, u64 seed_lo, u64 seed_hi)
+		{
+			alignas(32) u64 acc[8] = {
+			        s_prime32_3 ^ seed_lo, s_prime64_1 ^ seed_hi, s_prime64_2 ^ seed_lo, s_prime64_3 ^ seed_hi,
+			        s_prime64_4 ^ seed_lo, s_prime32_2 ^ seed_hi, s_prime64_5 ^ seed_lo, s_prime32_1 ^ seed_hi,
+			};
+
+			const HashBackend& backend = hash_backend();
+			const u64* secret          = s_secret.values;
+			const usize blocks         = (size - 1) / s_block_size;
+
+			for (usize block = 0; block < blocks; ++block)
+			{
+				backend.accumulate(acc, data + block * s_block_size, s_stripes_per_block, secret);
+				backend.scramble(acc, secret + s_scramble_key);
+			}
+
+			const usize tail    = blocks * s_block_size;
+			const usize stripes = (size - 1 - tail) / s_stripe_size;
+
+			backend.accumulate(acc, data + tail, stripes, secret);
+			backend.accumulate(acc, data + size - s_stripe_size, 1, secret + s_last_key);
+
+			const u64 lo = merge_accumulators(acc, secret + s_merge_lo_key, size * s_prime64_1);
+			const u64 hi = merge_accumulators(acc, secret + s_merge_hi_key, ~(size * s_prime64_2));
+			return make_hash(lo, hi);
+		}
+	}// namespace
+
+	ENGINE_EXPORT u128 memory_hash_fast(const void* memory, usize size, u128 seed)
+	{
+		const u8* data    = static_cast<const u8*>(memory);
+		const u64 seed_lo = static_cast<u64>(seed);
+		const u64 seed_hi = static_cast<u64>(seed >> 64);
+
+		if (size <= s_medium_threshold)
+			return hash_short(data, size, seed_lo, seed_hi);
+
+		if (size <= s_long_threshold)
+			return hash_medium(data, size, seed_lo, seed_hi);
+
+		return hash_long(data, size, seed_lo, seed_hi);
+	}
+}// namespace Trinex
@@ -52,4 +52,16 @@ namespace Trinex
 		static FileFlag flag(make_flag_from_string("TRINEX"), make_flag_from_string("ASSET"));
 		return flag;
 	}
+
+	const FileFlag& FileFlag::asset_imports_flag()
+	{
+		static FileFlag flag(make_flag_from_string("TRINEX"), make_flag_from_string("ASSETIMP"));
+		return flag;
+	}
+
+	const FileFlag& FileFlag::asset_schemas_flag()
+	{
+		static FileFlag flag(make_flag_from_string("TRINEX"), make_flag_from_string("ASSETSCH"));
+		return flag;
+	}
 }// namespace Trinex
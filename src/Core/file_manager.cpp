@@ -2,6 +2,8 @@
 #include <Core/filesystem/file.hpp>
 #include <Core/filesystem/root_filesystem.hpp>
 #include <Core/math/math.hpp>
+#include <Platform/platform.hpp>
+#include <cstring>
 
 namespace Trinex
 {
@@ -152,4 +154,112 @@ namespace Trinex
 	{
 		close();
 	}
+
+
+	MappedFileReader::MappedFileReader() = default;
+	MappedFileReader::MappedFileReader(const Path& path)
+	{
+		open(path);
+	}
+
+	MappedFileReader::MappedFileReader(MappedFileReader&& other)
+	    : m_data(other.m_data), m_size(other.m_size), m_position(other.m_position)
+	{
+		other.m_data     = nullptr;
+		other.m_size     = 0;
+		other.m_position = 0;
+	}
+
+	MappedFileReader& MappedFileReader::operator=(MappedFileReader&& other)
+	{
+		if (this != &other)
+		{
+			close();
+			m_data           = other.m_data;
+			m_size           = other.m_size;
+			m_position       = other.m_position;
+			other.m_data     = nullptr;
+			other.m_size     = 0;
+			other.m_position = 0;
+		}
+		return *this;
+	}
+
+	bool MappedFileReader::open(const Path& path)
+	{
+		close();
+
+		const Path native = rootfs()->native_path(path);
+
+		if (native.empty())
+			return false;
+
+		m_data = static_cast<const u8*>(Platform::map_file(native, m_size));
+
+		if (m_data)
+		{
+			Platform::advise_sequential_read(m_data, m_size);
+		}
+
+		return is_open();
+	}
+
+	MappedFileReader& MappedFileReader::close()
+	{
+		if (m_data)
+		{
+			Platform::unmap_file(m_data, m_size);
+			m_data = nullptr;
+		}
+
+		m_size     = 0;
+		m_position = 0;
+		return *this;
+	}
+
+	bool MappedFileReader::is_open() const
+	{
+		return m_data != nullptr;
+	}
+
+	bool MappedFileReader::read(u8* data, usize size)
+	{
+		if (const u8* view = read_view(size))
+		{
+			std::memcpy(data, view, size);
+			return true;
+		}
+		return false;
+	}
+
+	const u8* MappedFileReader::read_view(usize size)
+	{
+		if (!is_open() || m_position > m_size || size > m_size - m_position)
+			return nullptr;
+
+		const u8* view = m_data + m_position;
+		m_position += size;
+		return view;
+	}
+
+	MappedFileReader::ReadPos MappedFileReader::position()
+	{
+		return m_position;
+	}
+
+	MappedFileReader& MappedFileReader::offset(PosOffset offset, BufferSeekDir dir)
+	{
+		if (dir == BufferSeekDir::Begin)
+			m_position = 0;
+		else if (dir == BufferSeekDir::End)
+			m_position = m_size;
+
+		m_position += offset;
+		return *this;
+	}
+
+	MappedFileReader::~MappedFileReader()
+	{
+		close();
+	}
 }// namespace Trinex
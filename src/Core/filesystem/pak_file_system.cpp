@@ -0,0 +1,483 @@
+#include "vfs_log.hpp"
+#include <Core/etl/algorithm.hpp>
+#include <Core/file_manager.hpp>
+#include <Core/filesystem/directory_iterator.hpp>
+#include <Core/filesystem/file.hpp>
+#include <Core/filesystem/pak_file_system.hpp>
+#include <Core/filesystem/root_filesystem.hpp>
+#include <Core/math/math.hpp>
+#include <Core/memory.hpp>
+#include <Core/string_functions.hpp>
+#include <Engine/settings.hpp>
+#include <Platform/platform.hpp>
+#include <lz4hc.h>
+
+namespace Trinex::VFS
+{
+	namespace
+	{
+		static constexpr usize s_min_compressed_size = 256;
+
+		class PakFile : public File
+		{
+		private:
+			PakFileSystem* m_fs;
+			const u8* m_data;
+			usize m_size;
+			usize m_position = 0;
+			Buffer m_buffer;
+
+		public:
+			PakFile(PakFileSystem* fs, const u8* data, usize size) : m_fs(fs), m_data(data), m_size(size) {}
+			PakFile(PakFileSystem* fs, Buffer&& buffer)
+			    : m_fs(fs), m_data(buffer.data()), m_size(buffer.size()), m_buffer(std::move(buffer))
+			{}
+
+			FileSystem* filesystem() const override { return m_fs; }
+
+			FilePosition rseek(FileOffset offset, FileSeekDir dir) override
+			{
+				i64 base = 0;
+
+				if (dir == FileSeekDir::Current)
+					base = static_cast<i64>(m_position);
+				else if (dir == FileSeekDir::End)
+					base = static_cast<i64>(m_size);
+
+				m_position = static_cast<usize>(Math::clamp<i64>(base + offset, 0, static_cast<i64>(m_size)));
+				return m_position;
+			}
+
+			FilePosition rpos() override { return m_position; }
+			FilePosition wseek(FileOffset offset, FileSeekDir dir) override { return 0; }
+			FilePosition wpos() override { return 0; }
+
+			usize read(void* buffer, usize size) override
+			{
+				size = Math::min(size, m_size - m_position);
+				std::memcpy(buffer, m_data + m_position, size);
+				m_position += size;
+				return size;
+			}
+
+			usize write(const void* buffer, usize size) override { return 0; }
+		};
+
+		class PakIterator : public DirectoryIteratorInterface
+		{
+		public:
+			Vector<Path> m_paths;
+			usize m_index = 0;
+
+			bool next() override { return ++m_index < m_paths.size(); }
+			const Path& path() override { return m_paths[m_index]; }
+			bool is_valid() const override { return m_index < m_paths.size(); }
+
+			DirectoryIteratorInterface* copy() override
+			{
+				PakIterator* new_iterator = trx_new PakIterator();
+				new_iterator->m_paths     = m_paths;
+				new_iterator->m_index     = m_index;
+				return new_iterator;
+			}
+
+			Identifier id() const override
+			{
+				static const u8 value = 0;
+				return reinterpret_cast<Identifier>(&value);
+			}
+
+			bool is_equal(DirectoryIteratorInterface* other) override
+			{
+				auto iterator = static_cast<PakIterator*>(other);
+				return m_index == iterator->m_index && m_paths.size() == iterator->m_paths.size() &&
+				       etl::equal(m_paths.begin(), m_paths.end(), iterator->m_paths.begin());
+			}
+		};
+
+		// Returns true if the range [offset, offset + size) is inside of [0, limit). Written so that it can't overflow
+		static inline bool is_in_range(u64 offset, u64 size, u64 limit)
+		{
+			return offset <= limit && size <= limit - offset;
+		}
+
+		static bool is_valid_entry(const PakFileSystem::Entry& entry, u64 archive_size, u64 paths_size)
+		{
+			if (!is_in_range(entry.offset, entry.size, archive_size) || !is_in_range(entry.path_offset, entry.path_size, paths_size))
+				return false;
+
+			if (entry.compression == PakFileSystem::None)
+				return entry.size == entry.raw_size;
+
+			// LZ4 works with int sizes
+			constexpr u64 max_size = static_cast<u64>(LZ4_MAX_INPUT_SIZE);
+			return entry.compression == PakFileSystem::LZ4 && entry.size <= max_size && entry.raw_size <= max_size;
+		}
+
+		static StringView normalize(StringView path)
+		{
+			while (!path.empty() && path.front() == Path::separator) path.remove_prefix(1);
+			while (!path.empty() && path.back() == Path::separator) path.remove_suffix(1);
+
+			if (path == ".")
+				return {};
+			return path;
+		}
+	}// namespace
+
+	PakFileSystem::PakFileSystem(const Path& mount_point, const Path& archive) : FileSystem(mount_point), m_archive(archive)
+	{
+		const Path native = rootfs()->native_path(archive);
+		m_data            = static_cast<const u8*>(Platform::map_file(native, m_size));
+
+		if (m_data == nullptr)
+		{
+			vfs_error("Failed to map package archive '%s'", native.c_str());
+			return;
+		}
+
+		const Header* header = reinterpret_cast<const Header*>(m_data);
+
+		// Entries count is checked with division, so that a corrupted count can't overflow the size of the table
+		bool is_valid = m_size >= sizeof(Header) && header->magic == magic && header->version == version &&
+		                header->entries_offset <= m_size && header->entries_offset % alignof(Entry) == 0 &&
+		                header->entries_count <= (m_size - header->entries_offset) / sizeof(Entry) &&
+		                is_in_range(header->paths_offset, header->paths_size, m_size);
+
+		if (is_valid)
+		{
+			const Entry* entries = reinterpret_cast<const Entry*>(m_data + header->entries_offset);
+
+			for (usize index = 0; is_valid && index < header->entries_count; ++index)
+			{
+				is_valid = is_valid_entry(entries[index], m_size, header->paths_size) &&
+				           (index == 0 || entries[index - 1].hash <= entries[index].hash);
+			}
+		}
+
+		if (!is_valid)
+		{
+			vfs_error("Package archive '%s' is corrupted or has unsupported version", native.c_str());
+			Platform::unmap_file(m_data, m_size);
+			m_data = nullptr;
+			m_size = 0;
+			return;
+		}
+
+		m_entries       = reinterpret_cast<const Entry*>(m_data + header->entries_offset);
+		m_entries_count = header->entries_count;
+		m_paths         = reinterpret_cast<const char*>(m_data + header->paths_offset);
+
+		m_directories[String()];
+
+		for (usize index = 0; index < m_entries_count; ++index)
+		{
+			StringView child = path_of(m_entries + index);
+
+			while (true)
+			{
+				auto separator    = child.find_last_of(Path::separator);
+				StringView parent = separator == StringView::npos ? StringView() : child.substr(0, separator);
+
+				auto it               = m_directories.find(String(parent));
+				const bool is_created = it != m_directories.end();
+
+				if (!is_created)
+					it = m_directories.insert({String(parent), {}}).first;
+
+				it->second.emplace_back(child);
+
+				if (is_created)
+					break;
+
+				child = parent;
+			}
+		}
+	}
+
+	PakFileSystem::~PakFileSystem()
+	{
+		Platform::unmap_file(m_data, m_size);
+	}
+
+	void PakFileSystem::collect_recursive(const String& directory, Vector<Path>& paths) const
+	{
+		auto it = m_directories.find(directory);
+
+		if (it == m_directories.end())
+			return;
+
+		for (const String& child : it->second)
+		{
+			paths.push_back(mount_point() / Path(child));
+			collect_recursive(child, paths);
+		}
+	}
+
+	DirectoryIteratorInterface* PakFileSystem::create_directory_iterator(const Path& path)
+	{
+		auto it = m_directories.find(String(normalize(path.str())));
+
+		if (it == m_directories.end())
+			return nullptr;
+
+		PakIterator* iterator = trx_new PakIterator();
+		iterator->m_paths.reserve(it->second.size());
+
+		for (const String& child : it->second)
+		{
+			iterator->m_paths.push_back(mount_point() / Path(child));
+		}
+
+		return iterator;
+	}
+
+	DirectoryIteratorInterface* PakFileSystem::create_recursive_directory_iterator(const Path& path)
+	{
+		String directory(normalize(path.str()));
+
+		if (!m_directories.contains(directory))
+			return nullptr;
+
+		PakIterator* iterator = trx_new PakIterator();
+		collect_recursive(directory, iterator->m_paths);
+		return iterator;
+	}
+
+	bool PakFileSystem::cook(const Path& directory, const Path& archive)
+	{
+		if (!rootfs()->is_dir(directory))
+		{
+			vfs_error("Failed to cook package archive: '%s' is not a directory", directory.c_str());
+			return false;
+		}
+
+		const Path native_directory = rootfs()->native_path(directory);
+		const Path native_archive   = rootfs()->native_path(archive);
+
+		FileWriter writer(archive, true);
+
+		if (!writer.is_open())
+		{
+			vfs_error("Failed to open '%s' for writing", archive.c_str());
+			return false;
+		}
+
+		static const u8 padding[data_alignment] = {};
+
+		Header header = {};
+		writer.write(reinterpret_cast<const u8*>(&header), sizeof(header));
+
+		Vector<Entry> entries;
+		String paths;
+		Buffer compressed;
+
+		for (const Path& path : RecursiveDirectoryIterator(directory))
+		{
+			const Path native = rootfs()->native_path(path);
+
+			if (!rootfs()->is_file(path) || native == native_archive)
+				continue;
+
+			FileReader reader(path);
+
+			if (!reader.is_open())
+			{
+				vfs_error("Failed to read '%s'", path.c_str());
+				return false;
+			}
+
+			const String relative(normalize(native.relative(native_directory).str()));
+			Buffer raw = reader.read_buffer();
+
+			Entry entry       = {};
+			entry.hash        = Strings::hash_of(relative);
+			entry.size        = raw.size();
+			entry.raw_size    = raw.size();
+			entry.path_offset = static_cast<u32>(paths.size());
+			entry.path_size   = static_cast<u32>(relative.size());
+			entry.compression = None;
+
+			const u8* data = raw.data();
+
+			// Entry is compressed only if it saves at least an eighth of the size
+			if (raw.size() >= s_min_compressed_size)
+			{
+				const int bound = LZ4_compressBound(static_cast<int>(raw.size()));
+				compressed.resize(bound);
+
+				const int size = LZ4_compress_HC(reinterpret_cast<const char*>(raw.data()), reinterpret_cast<char*>(compressed.data()),
+				                                 static_cast<int>(raw.size()), bound, Settings::lz4_compression_level);
+
+				if (size > 0 && static_cast<usize>(size) < raw.size() - raw.size() / 8)
+				{
+					entry.size        = static_cast<u64>(size);
+					entry.compression = LZ4;
+					data              = compressed.data();
+				}
+			}
+
+			const usize position = writer.position();
+			writer.write(padding, align_up(position, data_alignment) - position);
+
+			entry.offset = writer.position();
+			writer.write(data, entry.size);
+
+			paths += relative;
+			entries.push_back(entry);
+		}
+
+		etl::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.hash < b.hash; });
+
+		for (usize index = 1; index < entries.size(); ++index)
+		{
+			if (entries[index].hash == entries[index - 1].hash)
+			{
+				StringView first(paths.data() + entries[index - 1].path_offset, entries[index - 1].path_size);
+				StringView second(paths.data() + entries[index].path_offset, entries[index].path_size);
+
+				vfs_error("Failed to cook package archive: paths '%.*s' and '%.*s' have the same hash", static_cast<int>(first.size()),
+				          first.data(), static_cast<int>(second.size()), second.data());
+				return false;
+			}
+		}
+
+		const usize position = writer.position();
+		writer.write(padding, align_up(position, alignof(Entry)) - position);
+
+		header.magic          = magic;
+		header.version        = version;
+		header.entries_offset = writer.position();
+		header.entries_count  = entries.size();
+		writer.write(reinterpret_cast<const u8*>(entries.data()), entries.size() * sizeof(Entry));
+
+		header.paths_offset = writer.position();
+		header.paths_size   = paths.size();
+		writer.write(reinterpret_cast<const u8*>(paths.data()), paths.size());
+
+		writer.offset(0, BufferSeekDir::Begin);
+		writer.write(reinterpret_cast<const u8*>(&header), sizeof(header));
+
+		vfs_log("Cooked %zu files from '%s' to '%s'", entries.size(), directory.c_str(), archive.c_str());
+		return true;
+	}
+
+	bool PakFileSystem::is_valid() const
+	{
+		return m_data != nullptr;
+	}
+
+	const PakFileSystem::Entry* PakFileSystem::find(StringView path) const
+	{
+		path           = normalize(path);
+		const u64 hash = Strings::hash_of(path);
+
+		const Entry* end   = m_entries + m_entries_count;
+		const Entry* entry = std::lower_bound(m_entries, end, hash, [](const Entry& entry, u64 hash) { return entry.hash < hash; });
+
+		if (entry != end && entry->hash == hash && path_of(entry) == path)
+			return entry;
+
+		return nullptr;
+	}
+
+	StringView PakFileSystem::path_of(const Entry* entry) const
+	{
+		return StringView(m_paths + entry->path_offset, entry->path_size);
+	}
+
+	const u8* PakFileSystem::data_of(const Entry* entry) const
+	{
+		return m_data + entry->offset;
+	}
+
+	const Path& PakFileSystem::path() const
+	{
+		return m_archive;
+	}
+
+	bool PakFileSystem::is_read_only() const
+	{
+		return true;
+	}
+
+	File* PakFileSystem::open(const Path& path, FileOpenMode mode)
+	{
+		if (mode & FileOpenMode::Write)
+		{
+			vfs_error("%s: Package archives are read only", path.c_str());
+			return nullptr;
+		}
+
+		const Entry* entry = find(path.str());
+
+		if (entry == nullptr)
+			return nullptr;
+
+		if (entry->compression == None)
+			return trx_new PakFile(this, data_of(entry), entry->size);
+
+		Buffer buffer(entry->raw_size);
+		const int size = LZ4_decompress_safe(reinterpret_cast<const char*>(data_of(entry)), reinterpret_cast<char*>(buffer.data()),
+		                                     static_cast<int>(entry->size), static_cast<int>(entry->raw_size));
+
+		if (size < 0 || static_cast<u64>(size) != entry->raw_size)
+		{
+			vfs_error("%s: Failed to decompress package entry", path.c_str());
+			return nullptr;
+		}
+
+		return trx_new PakFile(this, std::move(buffer));
+	}
+
+	PakFileSystem& PakFileSystem::close(File* file)
+	{
+		trx_delete file;
+		return *this;
+	}
+
+	bool PakFileSystem::create_dir(const Path& path)
+	{
+		return false;
+	}
+
+	bool PakFileSystem::remove(const Path& path)
+	{
+		return false;
+	}
+
+	bool PakFileSystem::copy(const Path& src, const Path& dest)
+	{
+		return false;
+	}
+
+	bool PakFileSystem::rename(const Path& src, const Path& dest)
+	{
+		return false;
+	}
+
+	bool PakFileSystem::is_exist(const Path& path) const
+	{
+		return is_file(path) || is_dir(path);
+	}
+
+	bool PakFileSystem::is_file(const Path& file) const
+	{
+		return find(file.str()) != nullptr;
+	}
+
+	bool PakFileSystem::is_dir(const Path& dir) const
+	{
+		return m_directories.contains(String(normalize(dir.str())));
+	}
+
+	PakFileSystem::Type PakFileSystem::type() const
+	{
+		return Type::Virtual;
+	}
+
+	Path PakFileSystem::native_path(const Path& path) const
+	{
+		return {};
+	}
+}// namespace Trinex::VFS
@@ -2,6 +2,7 @@
 #include <Core/filesystem/directory_iterator.hpp>
 #include <Core/filesystem/file.hpp>
 #include <Core/filesystem/file_watcher.hpp>
+#include <Core/filesystem/pak_file_system.hpp>
 #include <Core/filesystem/redirector.hpp>
 #include <Core/filesystem/root_filesystem.hpp>
 #include <Core/memory.hpp>
@@ -217,15 +218,44 @@ namespace Trinex::VFS
 			return false;
 		}
 
-		auto& file_system = m_file_systems[mount_point];
+		FileSystem* file_system = nullptr;
 
 		if (type == Native)
+		{
 			file_system = Platform::create_filesystem(mount_point, path);
+		}
+		else if (type == Virtual)
+		{
+			PakFileSystem* pak = trx_new PakFileSystem(mount_point, path);
 
+			if (!pak->is_valid())
+				trx_delete_inline(pak);
+			else
+				file_system = pak;
+		}
+
+		if (file_system == nullptr)
+		{
+			vfs_error("Failed to mount '%s' to '%s'", path.c_str(), mount_point.c_str());
+			return false;
+		}
+
+		m_file_systems[mount_point] = file_system;
 		vfs_log("Mounted '%s' to '%s'", file_system->path().c_str(), mount_point.c_str());
 		return true;
 	}
 
+	bool RootFS::pack_native_folder(const Path& native, const Path& virtual_fs, const StringView& password) const
+	{
+		if (!password.empty())
+		{
+			vfs_error("Failed to pack '%s': encrypted package archives are not supported", native.c_str());
+			return false;
+		}
+
+		return PakFileSystem::cook(native, virtual_fs);
+	}
+
 	RootFS& RootFS::unmount(const Path& mount_point)
 	{
 		auto it = m_file_systems.find(mount_point);
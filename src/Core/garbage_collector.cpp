@@ -1,178 +1,689 @@
 #include <Core/base_engine.hpp>
+#include <Core/etl/critical_section.hpp>
+#include <Core/etl/map.hpp>
 #include <Core/garbage_collector.hpp>
 #include <Core/math/math.hpp>
 #include <Core/object.hpp>
+#include <Core/object_handle.hpp>
 #include <Core/object_listener.hpp>
 #include <Core/package.hpp>
 #include <Core/reflection/class.hpp>
 #include <Core/reflection/property.hpp>
+#include <Core/threading.hpp>
 #include <Engine/settings.hpp>
-
-#define DISABLE_GC 1
+#include <chrono>
 
 namespace Trinex
 {
-	enum GCStage : EnumerateType
-	{
-		MarkUnreachable   = 0,
-		CollectingGarbage = 1,
-		DestroyGarbage    = 2,
+	CallBacks<void(Object*)> GarbageCollector::on_unreachable_check;
 
-		FirstStage = MarkUnreachable,
-		LastStage  = DestroyGarbage
-	};
+	namespace
+	{
+		// Flattened object references of a reflected struct. Nested structs with a known offset are inlined into the table of
+		// the owner, so scanning most objects is a loop over fixed offsets without virtual calls
+		struct ReferenceTable {
+			enum Kind : u8
+			{
+				ObjectRef,
+				ArrayRef,
+				StructRef,
+			};
+
+			struct Entry {
+				Kind kind;
+				isize offset;                 // Offset of the value, or of the resolver context if resolver is valid
+				Refl::Property* resolver;     // Computes the value address if it isn't a fixed offset from the context
+				Refl::ArrayProperty* array;   // Array property for the ArrayRef entries
+				const ReferenceTable* table;  // Table of the array elements or of the struct
+				usize stride;                 // Size of the array element
+			};
+
+			Vector<Entry> entries;
+			usize properties_count = 0;
+			bool is_complete       = false;
+
+			inline bool is_empty() const { return is_complete && entries.empty(); }
+		};
 
-	static struct GCState {
-		usize object_index = 0;
-		GCStage stage      = GCStage::MarkUnreachable;
-	} gc_state;
+		// Tables are built on first use and are never freed
+		class ReferenceTables
+		{
+		private:
+			Map<Refl::Struct*, ReferenceTable*> m_tables;
 
-	CallBacks<void(Object*)> GarbageCollector::on_unreachable_check;
+			ReferenceTable* element_table(Refl::ArrayProperty* array)
+			{
+				Refl::Property* element = array->element_property();
 
-	static FORCE_INLINE u32 get_max_objects_per_tick()
-	{
-		return Math::max<u32>(1, Settings::gc_max_object_per_tick);
-	}
+				// Struct tables are shared, so the array of the struct itself references the table which is being built
+				if (auto struct_prop = Refl::Object::instance_cast<Refl::StructProperty>(element))
+					return find(struct_prop->struct_instance());
 
-	void GarbageCollector::destroy(Object* object)
-	{
-		if (object == nullptr)
-			return;
+				ReferenceTable* table = trx_new ReferenceTable();
+				push(table, element, 0);
+				table->is_complete = true;
+				return table;
+			}
 
-		if (engine_instance && !engine_instance->is_shuting_down())
-		{
-			if (!object->is_noname())
+			void push(ReferenceTable* table, Refl::Property* prop, isize base)
 			{
-				trinex_debug(Log::Core, "Destroy object '%s'", object->string_name().c_str());
+				if (prop == nullptr || Refl::Object::instance_cast<Refl::VirtualProperty>(prop))
+					return;
+
+				const isize offset = prop->offset();
+
+				ReferenceTable::Entry entry;
+				entry.offset   = offset >= 0 ? base + offset : base;
+				entry.resolver = offset >= 0 ? nullptr : prop;
+				entry.array    = nullptr;
+				entry.table    = nullptr;
+				entry.stride   = 0;
+
+				if (Refl::Object::instance_cast<Refl::ObjectProperty>(prop))
+				{
+					entry.kind = ReferenceTable::ObjectRef;
+					table->entries.push_back(entry);
+				}
+				else if (auto array = Refl::Object::instance_cast<Refl::ArrayProperty>(prop))
+				{
+					ReferenceTable* elements = element_table(array);
+
+					if (elements->is_empty())
+						return;
+
+					entry.kind   = ReferenceTable::ArrayRef;
+					entry.array  = array;
+					entry.table  = elements;
+					entry.stride = array->element_size();
+					table->entries.push_back(entry);
+				}
+				else if (auto struct_prop = Refl::Object::instance_cast<Refl::StructProperty>(prop))
+				{
+					ReferenceTable* members = find(struct_prop->struct_instance());
+
+					if (members->is_empty())
+						return;
+
+					if (entry.resolver == nullptr)
+					{
+						for (ReferenceTable::Entry member : members->entries)
+						{
+							member.offset += entry.offset;
+							table->entries.push_back(member);
+						}
+					}
+					else
+					{
+						entry.kind  = ReferenceTable::StructRef;
+						entry.table = members;
+						table->entries.push_back(entry);
+					}
+				}
 			}
-			else
+
+		public:
+			ReferenceTable* find(Refl::Struct* self)
 			{
-				trinex_debug(Log::Core, "Destroy noname object with type '%s'", object->class_instance()->full_name().c_str());
+				const usize count      = self->properties_count(true);
+				ReferenceTable*& table = m_tables[self];
+
+				if (table && table->properties_count == count)
+					return table;
+
+				// Script classes can add properties after the table was built. Previous table is kept alive, because
+				// other marking threads may still scan it
+				ReferenceTable* current   = trx_new ReferenceTable();
+				current->properties_count = count;
+				table                     = current;
+
+				for (Refl::Struct* scope = self; scope; scope = scope->parent())
+				{
+					for (Refl::Property* prop : scope->properties())
+					{
+						push(current, prop, 0);
+					}
+				}
+
+				current->is_complete = true;
+				return current;
 			}
-		}
+		};
+	}// namespace
 
-		object->on_destroy();
-		ObjectDestroyListener::for_each_invoke(object);
-		object->class_instance()->destroy_object(object);
-	}
+	// Objects are white if their epoch differs from the epoch of the current cycle.
+	// Gray objects have the current epoch and are in the gray stack, black objects have the current epoch and were scanned
+	struct GarbageCollector::Collector {
+		enum Phase : u8
+		{
+			Idle,
+			Roots,
+			Mark,
+			Sweep,
+		};
 
-	void GarbageCollector::update(float dt)
-	{
-		if (Object::static_objects().empty())
-			return;
+		static constexpr usize s_clock_interval     = 64;
+		static constexpr usize s_packet_size        = 256;
+		static constexpr usize s_parallel_threshold = 1024;
+		static constexpr u64 s_parallel_min_time    = 500000;
+
+		CriticalSection tables_cs;
+		ReferenceTables tables;
+		Vector<ObjectHandle> gray;
+
+		CriticalSection barrier_cs;
+		Vector<ObjectHandle> barrier_gray;
+
+		Atomic<u32> epoch = 1;
+		Atomic<u8> phase  = Idle;
 
-		if (gc_state.stage == GCStage::MarkUnreachable)
+		u32 cursor    = 0;
+		u32 end       = 0;
+		usize marked  = 0;
+		usize removed = 0;
+		f64 time      = 0.0;
+
+		Statistics statistics;
+
+		static Collector& instance()
 		{
-			mark_unreachable(dt);
+			// Objects can be created and destroyed by static constructors and destructors
+			alignas(Collector) static u8 storage[sizeof(Collector)];
+			static Collector* collector = new (storage) Collector();
+			return *collector;
 		}
-		else if (gc_state.stage == GCStage::CollectingGarbage)
+
+		static inline u64 now()
 		{
-			collect_garbage(dt);
+			using namespace std::chrono;
+			return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
 		}
-		else if (gc_state.stage == GCStage::DestroyGarbage)
+
+		static inline bool is_root(Object* object)
 		{
-			destroy_garbage(dt);
+			return object->flags.any(Object::Flags::StandAlone) || !object->flags.all(Object::Flags::IsAvailableForGC) ||
+			       object->references() > 0 || object->owner() != nullptr;
 		}
-	}
 
-	void GarbageCollector::submit_current_stage()
-	{
-		gc_state.object_index = 0;
+		// Marks objects into its own stack, so every marking thread uses a separate marker
+		struct Marker {
+			Collector& collector;
+			Vector<ObjectHandle>& stack;
+			Map<Refl::Struct*, const ReferenceTable*>* cache;
+			u32 current;
+			usize marked = 0;
+
+			Marker(Collector& collector, Vector<ObjectHandle>& stack, Map<Refl::Struct*, const ReferenceTable*>* cache = nullptr)
+			    : collector(collector), stack(stack), cache(cache), current(collector.epoch.load(etl::memory_order_relaxed))
+			{}
+
+			// Mark bit is claimed atomically, only one thread pushes the object even if it is reached by several threads.
+			// Flags aren't atomic, so the IsUnreachable flag of marked objects is cleared by the sweep on the calling thread
+			inline void shade(Object* object)
+			{
+				if (object && object->m_gc_epoch.load(etl::memory_order_relaxed) != current &&
+				    object->m_gc_epoch.exchange(current, etl::memory_order_relaxed) != current)
+				{
+					stack.push_back(object);
+				}
+			}
+
+			const ReferenceTable* table(Refl::Struct* self)
+			{
+				if (cache == nullptr)
+					return collector.tables.find(self);
+
+				const ReferenceTable*& result = (*cache)[self];
+
+				if (result == nullptr)
+				{
+					ScopeLock lock(collector.tables_cs);
+					result = collector.tables.find(self);
+				}
+
+				return result;
+			}
+
+			void scan(const ReferenceTable* table, u8* context)
+			{
+				for (const ReferenceTable::Entry& entry : table->entries)
+				{
+					u8* address = entry.resolver ? reinterpret_cast<u8*>(entry.resolver->address(context + entry.offset))
+					                             : context + entry.offset;
+
+					if (address == nullptr)
+						continue;
+
+					switch (entry.kind)
+					{
+						case ReferenceTable::ObjectRef: shade(*reinterpret_cast<Object**>(address)); break;
+						case ReferenceTable::StructRef: scan(entry.table, address); break;
+						case ReferenceTable::ArrayRef:
+						{
+							const usize length = entry.array->length(address, true);
+
+							if (length == 0)
+								break;
+
+							u8* data = reinterpret_cast<u8*>(entry.array->at(address, 0, true));
+
+							for (usize i = 0; i < length; ++i, data += entry.stride)
+							{
+								scan(entry.table, data);
+							}
+							break;
+						}
+					}
+				}
+			}
+
+			// Scans the object on top of the stack
+			inline void process()
+			{
+				Object* object = stack.back().object();
+				stack.pop_back();
+
+				if (object == nullptr)
+					return;
+
+				++marked;
+				shade(object->owner());
+
+				if (Refl::Class* class_instance = object->class_instance())
+				{
+					scan(table(class_instance), reinterpret_cast<u8*>(object));
+				}
+			}
+		};
+
+		// State shared by the marking threads. Threads publish packets of their stacks while others are starving,
+		// marking is finished when no packets are left and no thread holds a non-empty stack
+		struct ParallelMark {
+			CriticalSection cs;
+			Vector<Vector<ObjectHandle>> packets;
+			u32 active = 0;
 
-		EnumerateType value = gc_state.stage + 1;
-		if (value > LastStage)
+			Atomic<u32> starving  = 0;
+			Atomic<usize> marked  = 0;
+			Atomic<bool> timeout  = false;
+		};
+
+		void mark_worker(ParallelMark& shared, u64 deadline)
 		{
-			value = FirstStage;
-		}
-		gc_state.stage = static_cast<GCStage>(value);
-	}
+			Map<Refl::Struct*, const ReferenceTable*> cache;
+			Vector<ObjectHandle> stack;
+			Marker marker(*this, stack, &cache);
 
-	bool GarbageCollector::process_objects(void (*callback)(Object* object))
-	{
-		const auto& objects  = Object::static_objects();
-		u32 objects_per_tick = get_max_objects_per_tick();
-		auto objects_count   = objects.size();
+			bool is_active   = false;
+			bool is_starving = false;
+			usize work       = 0;
+
+			while (true)
+			{
+				if (stack.empty())
+				{
+					bool is_finished = false;
+					{
+						ScopeLock lock(shared.cs);
+
+						if (is_active)
+						{
+							--shared.active;
+							is_active = false;
+						}
+
+						if (!shared.packets.empty() && !shared.timeout.load(etl::memory_order_relaxed))
+						{
+							stack = std::move(shared.packets.back());
+							shared.packets.pop_back();
+							++shared.active;
+							is_active = true;
+						}
+						else
+						{
+							is_finished = shared.active == 0 || shared.timeout.load(etl::memory_order_relaxed);
+						}
+					}
+
+					if (is_active && is_starving)
+					{
+						shared.starving.fetch_sub(1, etl::memory_order_relaxed);
+						is_starving = false;
+					}
+
+					if (is_finished)
+						break;
+
+					if (!is_active)
+					{
+						if (!is_starving)
+						{
+							shared.starving.fetch_add(1, etl::memory_order_relaxed);
+							is_starving = true;
+						}
+
+						Thread::static_yield();
+						continue;
+					}
+				}
+
+				if (++work % s_clock_interval == 0 && now() >= deadline)
+					shared.timeout.store(true, etl::memory_order_relaxed);
+
+				if (shared.timeout.load(etl::memory_order_relaxed))
+				{
+					ScopeLock lock(shared.cs);
+					shared.packets.push_back(std::move(stack));
+					stack.clear();
+					--shared.active;
+					is_active = false;
+					break;
+				}
+
+				marker.process();
+
+				if (stack.size() >= 2 * s_packet_size && shared.starving.load(etl::memory_order_relaxed) > 0)
+				{
+					Vector<ObjectHandle> packet(stack.end() - s_packet_size, stack.end());
+					stack.resize(stack.size() - s_packet_size);
+
+					ScopeLock lock(shared.cs);
+					shared.packets.push_back(std::move(packet));
+				}
+			}
+
+			if (is_starving)
+				shared.starving.fetch_sub(1, etl::memory_order_relaxed);
+
+			shared.marked.fetch_add(marker.marked, etl::memory_order_relaxed);
+		}
 
-		while (objects_per_tick > 0 && gc_state.object_index < objects_count)
+		// Drains the gray stack on the worker threads, returns false if the deadline was reached
+		bool process_gray_parallel(u64 deadline, u32 threads)
 		{
-			Object* object = objects[gc_state.object_index];
+			ParallelMark shared;
 
-			if (object)
+			for (usize index = 0; index < gray.size(); index += s_packet_size)
 			{
-				--objects_per_tick;
-				callback(object);
+				auto packet_end = gray.begin() + Math::min(index + s_packet_size, gray.size());
+				shared.packets.emplace_back(gray.begin() + index, packet_end);
 			}
 
-			++gc_state.object_index;
+			gray.clear();
+
+			Task task(Task::High, [this, &shared, deadline]() { mark_worker(shared, deadline); });
+			task.max_threads(threads);
+			TaskGraph::instance()->wait_for(task);
+
+			marked += shared.marked.load(etl::memory_order_relaxed);
+
+			for (auto& packet : shared.packets)
+			{
+				gray.insert(gray.end(), packet.begin(), packet.end());
+			}
+
+			return !shared.timeout.load(etl::memory_order_relaxed);
 		}
 
-		if (gc_state.object_index == objects_count)
+		void begin_cycle()
 		{
-			submit_current_stage();
-			return true;
+			u32 next = epoch.load(etl::memory_order_relaxed) + 1;
+			epoch.store(next == 0 ? 1 : next, etl::memory_order_relaxed);
+
+			cursor  = 0;
+			marked  = 0;
+			removed = 0;
+			time    = 0.0;
+			phase.store(Roots, etl::memory_order_release);
 		}
-		return false;
-	}
 
-	void GarbageCollector::mark_unreachable(float dt)
-	{
-		static void (*callback)(Object* object) = [](Object* object) { object->flags |= Object::Flags::IsUnreachable; };
-		process_objects(callback);
-	}
+		bool process_roots(u64 deadline)
+		{
+			Marker marker(*this, gray);
+			const u32 current = marker.current;
+			const u32 count   = ObjectHandle::static_slots_count();
 
-	static void find_unreachable(Object* object)
-	{
-		GarbageCollector::on_unreachable_check(object);
+			for (usize work = 1; cursor < count; ++cursor, ++work)
+			{
+				if (work % s_clock_interval == 0 && now() >= deadline)
+					return false;
 
-		auto& flags = object->flags;
+				Object* object = ObjectHandle::static_find_object(cursor);
 
-		if (flags.any(Object::Flags::StandAlone) || object->references() > 0 || object->owner() != nullptr)
-		{
-			object->flags.remove(Object::Flags::IsUnreachable);
+				if (object == nullptr || object->m_gc_epoch.load(etl::memory_order_relaxed) == current)
+					continue;
+
+				if (!is_root(object))
+				{
+					object->flags |= Object::Flags::IsUnreachable;
+					on_unreachable_check(object);
+
+					if (object->flags.all(Object::Flags::IsUnreachable))
+						continue;
+				}
+
+				marker.shade(object);
+			}
+
+			phase.store(Mark, etl::memory_order_release);
+			return true;
 		}
 
-		if (!object->flags.all(Object::Flags::IsUnreachable))
+		bool process_gray(u64 deadline)
 		{
-			Refl::Class* class_instance = object->class_instance();
+			Marker marker(*this, gray);
+			usize work = 0;
+
+			u32 threads = TaskGraph::instance()->workers() + 1;
 
-			if (class_instance)
+			if (Settings::gc_mark_threads > 0)
+				threads = Math::min<u32>(threads, Settings::gc_mark_threads);
+
+			while (true)
 			{
-				for (auto& prop : class_instance->properties())
+				if (gray.empty())
 				{
-					if (!prop)
+					// The phase is switched under the lock, so that barriers never push into the stack after marking is done
+					ScopeLock lock(barrier_cs);
+
+					if (barrier_gray.empty())
 					{
-						continue;
+						marked += marker.marked;
+						end    = ObjectHandle::static_slots_count();
+						cursor = 0;
+						phase.store(Sweep, etl::memory_order_release);
+						return true;
 					}
 
-					if (auto object_prop = Refl::Object::instance_cast<Refl::ObjectProperty>(prop))
+					std::swap(gray, barrier_gray);
+				}
+
+				// Waking the workers isn't worth it for short time slices
+				if (threads > 1 && gray.size() >= s_parallel_threshold &&
+				    deadline - Math::min(deadline, now()) >= s_parallel_min_time)
+				{
+					if (!process_gray_parallel(deadline, threads))
 					{
-						Object* prop_object = object_prop->object(object);
-						if (prop_object)
-						{
-							prop_object->flags.remove(Object::Flags::IsUnreachable);
-						}
+						marked += marker.marked;
+						return false;
 					}
+					continue;
+				}
+
+				if (++work % s_clock_interval == 0 && now() >= deadline)
+				{
+					marked += marker.marked;
+					return false;
+				}
+
+				marker.process();
+			}
+		}
+
+		bool process_sweep(u64 deadline)
+		{
+			const u32 current = epoch.load(etl::memory_order_relaxed);
+
+			for (usize work = 1; cursor < end; ++cursor, ++work)
+			{
+				if (work % s_clock_interval == 0 && now() >= deadline)
+					return false;
+
+				Object* object = ObjectHandle::static_find_object(cursor);
+
+				if (object == nullptr)
+					continue;
+
+				// Objects which became roots during the cycle survive even if a barrier was missed
+				if (object->m_gc_epoch.load(etl::memory_order_relaxed) == current || is_root(object))
+				{
+					object->flags.remove(Object::Flags::IsUnreachable);
+					continue;
 				}
+
+				GarbageCollector::destroy(object);
+				++removed;
 			}
+
+			statistics.cycles += 1;
+			statistics.marked_objects = marked;
+			statistics.destroyed      = removed;
+			statistics.cycle_time     = time;
+			statistics.total_destroyed += removed;
+
+			phase.store(Idle, etl::memory_order_release);
+			return true;
 		}
+
+		// Returns true if the cycle is finished
+		bool step(u64 deadline)
+		{
+			const u64 start = now();
+
+			if (phase.load(etl::memory_order_relaxed) == Idle)
+				begin_cycle();
+
+			bool is_running = true;
+
+			if (phase.load(etl::memory_order_relaxed) == Roots)
+				is_running = process_roots(deadline);
+
+			if (is_running && phase.load(etl::memory_order_relaxed) == Mark)
+				is_running = process_gray(deadline);
+
+			time += static_cast<f64>(now() - start) / 1000000.0;
+
+			if (is_running && phase.load(etl::memory_order_relaxed) == Sweep)
+				return process_sweep(deadline);
+
+			return false;
+		}
+
+		void write_barrier(Object* object)
+		{
+			const u8 current_phase = phase.load(etl::memory_order_acquire);
+
+			if (current_phase == Idle)
+				return;
+
+			const u32 current = epoch.load(etl::memory_order_relaxed);
+
+			if (object->m_gc_epoch.load(etl::memory_order_relaxed) == current)
+				return;
+
+			ScopeLock lock(barrier_cs);
+
+			if (object->m_gc_epoch.exchange(current, etl::memory_order_relaxed) == current)
+				return;
+
+			// References of objects shaded during the sweep are not scanned, their referents are already marked or swept
+			if (phase.load(etl::memory_order_relaxed) != Sweep)
+				barrier_gray.push_back(object);
+		}
+
+		void reset()
+		{
+			gray.clear();
+			{
+				ScopeLock lock(barrier_cs);
+				barrier_gray.clear();
+			}
+			phase.store(Idle, etl::memory_order_release);
+		}
+	};
+
+	void GarbageCollector::destroy(Object* object)
+	{
+		if (object == nullptr)
+			return;
+
+		if (engine_instance && !engine_instance->is_shuting_down())
+		{
+			if (!object->is_noname())
+			{
+				trinex_debug(Log::Core, "Destroy object '%s'", object->string_name().c_str());
+			}
+			else
+			{
+				trinex_debug(Log::Core, "Destroy noname object with type '%s'", object->class_instance()->full_name().c_str());
+			}
+		}
+
+		object->on_destroy();
+		ObjectDestroyListener::for_each_invoke(object);
+		object->class_instance()->destroy_object(object);
 	}
 
+	void GarbageCollector::update(float dt)
+	{
+		if (Settings::gc_time_budget <= 0.f)
+			return;
+
+		const u64 budget = static_cast<u64>(static_cast<f64>(Settings::gc_time_budget) * 1000000.0);
+		Collector::instance().step(Collector::now() + budget);
+	}
 
-	void GarbageCollector::collect_garbage(float dt)
+	void GarbageCollector::write_barrier(const Object* object)
 	{
-		process_objects(find_unreachable);
+		if (object)
+		{
+			Collector::instance().write_barrier(const_cast<Object*>(object));
+		}
 	}
 
-	void GarbageCollector::destroy_garbage(float dt)
+	void GarbageCollector::collect()
 	{
-		static void (*callback)(Object* object) = [](Object* object) {
-			if (object->flags.all(Object::Flags::IsUnreachable))
-			{
-				destroy(object);
-			}
-		};
+		Collector& collector = Collector::instance();
+
+		if (collector.phase.load(etl::memory_order_relaxed) != Collector::Idle)
+			collector.step(~static_cast<u64>(0));
+
+		collector.step(~static_cast<u64>(0));
+	}
 
-		process_objects(callback);
+	bool GarbageCollector::is_collecting()
+	{
+		return Collector::instance().phase.load(etl::memory_order_relaxed) != Collector::Idle;
+	}
+
+	bool GarbageCollector::is_marked(const Object* object)
+	{
+		return object && object->m_gc_epoch.load(etl::memory_order_relaxed) ==
+		                         Collector::instance().epoch.load(etl::memory_order_relaxed);
+	}
+
+	GarbageCollector::Statistics GarbageCollector::statistics()
+	{
+		return Collector::instance().statistics;
+	}
+
+	void GarbageCollector::on_object_created(Object* object)
+	{
+		Collector& collector = Collector::instance();
+		object->m_gc_epoch.store(0, etl::memory_order_relaxed);
+
+		// Objects created while marking are scanned before the sweep, the fields assigned by their constructors may not use
+		// barriers. Objects created during the sweep are black and are not swept
+		collector.write_barrier(object);
 	}
 
 	static bool destroy_recursive(Object* object)
@@ -183,7 +694,7 @@ namespace Trinex
 		if (!object->flags.all(Object::Flags::IsAvailableForGC))
 			return false;
 
-		auto index = object->global_index();
+		ObjectHandle handle = object;
 
 		if (Object* owner = object->owner())
 		{
@@ -191,7 +702,7 @@ namespace Trinex
 				return false;
 
 			// Maybe this object is already destroyed, check it
-			if (Object::static_objects()[index] != object)
+			if (!handle.is_valid())
 				return true;
 		}
 
@@ -201,6 +712,8 @@ namespace Trinex
 
 	void GarbageCollector::destroy_all_objects()
 	{
+		Collector::instance().reset();
+
 		auto& objects = const_cast<Vector<Object*>&>(Object::static_objects());
 
 		usize index = 0;
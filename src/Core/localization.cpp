@@ -77,7 +77,7 @@ namespace Trinex
 		}
 	}
 
-	static void load_localization(Map<u64, String>& out, const Path& path)
+	static void load_localization(NodeMap<u64, String>& out, const Path& path)
 	{
 		std::stringstream stream;
 
@@ -1,8 +1,329 @@
 #include <Core/math/math.hpp>
 #include <Core/memory.hpp>
+#include <bit>
+
+#if ARCH_X86_64
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 
 namespace Trinex
 {
+	namespace
+	{
+		template<usize size>
+		struct Element {
+			u8 bytes[size];
+		};
+
+		// Fixed element size lets the compiler replace memcpy calls with plain register moves
+		template<usize size>
+		static void copy_strided(u8* dst, const u8* src, usize count, usize dst_stride, usize src_stride)
+		{
+			using Type = Element<size>;
+
+			for (; count >= 4; count -= 4)
+			{
+				Type e0, e1, e2, e3;
+				std::memcpy(&e0, src, size);
+				std::memcpy(&e1, src + src_stride, size);
+				std::memcpy(&e2, src + src_stride * 2, size);
+				std::memcpy(&e3, src + src_stride * 3, size);
+
+				std::memcpy(dst, &e0, size);
+				std::memcpy(dst + dst_stride, &e1, size);
+				std::memcpy(dst + dst_stride * 2, &e2, size);
+				std::memcpy(dst + dst_stride * 3, &e3, size);
+
+				src += src_stride * 4;
+				dst += dst_stride * 4;
+			}
+
+			for (; count > 0; --count, src += src_stride, dst += dst_stride)
+			{
+				std::memcpy(dst, src, size);
+			}
+		}
+
+		// Crochemore-Perrin two-way string matching. Used when the vectorized search verifies too many candidates,
+		// guarantees linear time for any input
+		static isize maximal_suffix(const u8* needle, isize length, bool reversed, isize& period)
+		{
+			isize suffix = -1;
+			isize j      = 0;
+			isize k      = 1;
+			period       = 1;
+
+			while (j + k < length)
+			{
+				const u8 a = needle[j + k];
+				const u8 b = needle[suffix + k];
+
+				if (reversed ? a > b : a < b)
+				{
+					j += k;
+					k      = 1;
+					period = j - suffix;
+				}
+				else if (a == b)
+				{
+					if (k != period)
+					{
+						++k;
+					}
+					else
+					{
+						j += period;
+						k = 1;
+					}
+				}
+				else
+				{
+					suffix = j;
+					j      = suffix + 1;
+					k      = 1;
+					period = 1;
+				}
+			}
+
+			return suffix;
+		}
+
+		static const u8* two_way_search(const u8* haystack, isize haystack_len, const u8* needle, isize needle_len)
+		{
+			isize period;
+			isize reversed_period;
+
+			const isize suffix          = maximal_suffix(needle, needle_len, false, period);
+			const isize reversed_suffix = maximal_suffix(needle, needle_len, true, reversed_period);
+
+			isize critical = suffix;
+
+			if (suffix < reversed_suffix)
+			{
+				critical = reversed_suffix;
+				period   = reversed_period;
+			}
+
+			if (std::memcmp(needle, needle + period, critical + 1) == 0)
+			{
+				// Periodic needle, remember the matched prefix to skip it after a shift by the period
+				isize memory = -1;
+
+				for (isize j = 0; j <= haystack_len - needle_len;)
+				{
+					isize i = Math::max(critical, memory) + 1;
+
+					while (i < needle_len && needle[i] == haystack[i + j]) ++i;
+
+					if (i >= needle_len)
+					{
+						i = critical;
+
+						while (i > memory && needle[i] == haystack[i + j]) --i;
+
+						if (i <= memory)
+							return haystack + j;
+
+						j += period;
+						memory = needle_len - period - 1;
+					}
+					else
+					{
+						j += i - critical;
+						memory = -1;
+					}
+				}
+			}
+			else
+			{
+				period = Math::max(critical + 1, needle_len - critical - 1) + 1;
+
+				for (isize j = 0; j <= haystack_len - needle_len;)
+				{
+					isize i = critical + 1;
+
+					while (i < needle_len && needle[i] == haystack[i + j]) ++i;
+
+					if (i >= needle_len)
+					{
+						i = critical;
+
+						while (i >= 0 && needle[i] == haystack[i + j]) --i;
+
+						if (i < 0)
+							return haystack + j;
+
+						j += period;
+					}
+					else
+					{
+						j += i - critical;
+					}
+				}
+			}
+
+			return nullptr;
+		}
+
+		// Candidate positions are found by comparing the first and the last byte of the needle with a whole register of the
+		// haystack at once, only positions where both bytes match are compared with memcmp. When the compared bytes exceed
+		// the haystack length, the rest of the haystack is searched by the two-way algorithm
+		struct SearchState {
+			const u8* haystack;
+			usize haystack_len;
+			const u8* needle;
+			usize needle_len;
+			usize budget;
+
+			FORCE_INLINE bool verify(usize position)
+			{
+				budget -= Math::min(budget, needle_len);
+				return std::memcmp(haystack + position + 1, needle + 1, needle_len - 2) == 0;
+			}
+
+			FORCE_INLINE bool exhausted() const { return budget == 0; }
+
+			const u8* finish(usize position)
+			{
+				if (exhausted())
+				{
+					return two_way_search(haystack + position, static_cast<isize>(haystack_len - position), needle,
+					                      static_cast<isize>(needle_len));
+				}
+
+				for (const usize last = haystack_len - needle_len; position <= last; ++position)
+				{
+					if (haystack[position] == needle[0] && haystack[position + needle_len - 1] == needle[needle_len - 1] &&
+					    std::memcmp(haystack + position, needle, needle_len) == 0)
+					{
+						return haystack + position;
+					}
+				}
+
+				return nullptr;
+			}
+		};
+
+		template<typename Block>
+		static FORCE_INLINE const u8* search_candidates(SearchState& state, usize position, Block mask)
+		{
+			while (mask)
+			{
+				const usize offset = position + std::countr_zero(mask);
+
+				if (state.verify(offset))
+					return state.haystack + offset;
+
+				mask &= mask - 1;
+			}
+
+			return nullptr;
+		}
+
+		using SearchFunction = const u8* (*)(SearchState& state);
+
+#if ARCH_X86_64
+		static const u8* search_sse2(SearchState& state)
+		{
+			const __m128i first = _mm_set1_epi8(static_cast<char>(state.needle[0]));
+			const __m128i last  = _mm_set1_epi8(static_cast<char>(state.needle[state.needle_len - 1]));
+			const u8* haystack  = state.haystack;
+			const usize end     = state.haystack_len - state.needle_len + 1;
+			usize position      = 0;
+
+			for (; position + 16 <= end && !state.exhausted(); position += 16)
+			{
+				const __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + position));
+				const __m128i block_last =
+				        _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + position + state.needle_len - 1));
+
+				const __m128i equal_first = _mm_cmpeq_epi8(first, block_first);
+				const __m128i equal_last  = _mm_cmpeq_epi8(last, block_last);
+				const u32 mask            = static_cast<u32>(_mm_movemask_epi8(_mm_and_si128(equal_first, equal_last)));
+
+				if (const u8* result = search_candidates(state, position, mask))
+					return result;
+			}
+
+			return state.finish(position);
+		}
+
+		__attribute__((target("avx2"))) static const u8* search_avx2(SearchState& state)
+		{
+			const __m256i first = _mm256_set1_epi8(static_cast<char>(state.needle[0]));
+			const __m256i last  = _mm256_set1_epi8(static_cast<char>(state.needle[state.needle_len - 1]));
+			const u8* haystack  = state.haystack;
+			const usize end     = state.haystack_len - state.needle_len + 1;
+			usize position      = 0;
+
+			for (; position + 32 <= end && !state.exhausted(); position += 32)
+			{
+				const __m256i block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + position));
+				const __m256i block_last =
+				        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + position + state.needle_len - 1));
+
+				const __m256i equal_first = _mm256_cmpeq_epi8(first, block_first);
+				const __m256i equal_last  = _mm256_cmpeq_epi8(last, block_last);
+				const u32 mask            = static_cast<u32>(_mm256_movemask_epi8(_mm256_and_si256(equal_first, equal_last)));
+
+				if (const u8* result = search_candidates(state, position, mask))
+					return result;
+			}
+
+			return state.finish(position);
+		}
+#elif defined(__ARM_NEON)
+		static const u8* search_neon(SearchState& state)
+		{
+			const uint8x16_t first = vdupq_n_u8(state.needle[0]);
+			const uint8x16_t last  = vdupq_n_u8(state.needle[state.needle_len - 1]);
+			const u8* haystack     = state.haystack;
+			const usize end        = state.haystack_len - state.needle_len + 1;
+			usize position         = 0;
+
+			for (; position + 16 <= end && !state.exhausted(); position += 16)
+			{
+				const uint8x16_t block_first = vld1q_u8(haystack + position);
+				const uint8x16_t block_last  = vld1q_u8(haystack + position + state.needle_len - 1);
+				const uint8x16_t equal       = vandq_u8(vceqq_u8(first, block_first), vceqq_u8(last, block_last));
+
+				// Narrowing shift packs every byte of the comparison into 4 bits of the mask
+				u64 mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(equal), 4)), 0);
+
+				while (mask)
+				{
+					const usize offset = position + (std::countr_zero(mask) >> 2);
+
+					if (state.verify(offset))
+						return haystack + offset;
+
+					mask &= ~(u64(0xF) << std::countr_zero(mask));
+				}
+			}
+
+			return state.finish(position);
+		}
+#else
+		static const u8* search_scalar(SearchState& state)
+		{
+			return state.finish(0);
+		}
+#endif
+
+		static SearchFunction select_search_function()
+		{
+#if ARCH_X86_64
+			return __builtin_cpu_supports("avx2") ? search_avx2 : search_sse2;
+#elif defined(__ARM_NEON)
+			return search_neon;
+#else
+			return search_scalar;
+#endif
+		}
+	}// namespace
+
 	ENGINE_EXPORT void* memcpy_elements(void* dst, const void* src, usize element_size, usize element_count, usize dst_stride,
 	                                    usize src_stride)
 	{
@@ -20,6 +341,19 @@ namespace Trinex
 
 		element_size = Math::min(dst_stride, src_stride);
 
+		switch (element_size)
+		{
+			case 1: copy_strided<1>(d, s, element_count, dst_stride, src_stride); return dst;
+			case 2: copy_strided<2>(d, s, element_count, dst_stride, src_stride); return dst;
+			case 4: copy_strided<4>(d, s, element_count, dst_stride, src_stride); return dst;
+			case 8: copy_strided<8>(d, s, element_count, dst_stride, src_stride); return dst;
+			case 12: copy_strided<12>(d, s, element_count, dst_stride, src_stride); return dst;
+			case 16: copy_strided<16>(d, s, element_count, dst_stride, src_stride); return dst;
+			case 32: copy_strided<32>(d, s, element_count, dst_stride, src_stride); return dst;
+			case 64: copy_strided<64>(d, s, element_count, dst_stride, src_stride); return dst;
+			default: break;
+		}
+
 		for (usize i = 0; i < element_count; ++i)
 		{
 			memcpy(d, s, element_size);
@@ -56,14 +390,13 @@ namespace Trinex
 		if (needle_len == 0)
 			return haystack;
 
-		for (usize i = 0, count = haystack_len - needle_len; i <= count; ++i)
-		{
-			if (memcmp(haystack + i, needle, needle_len) == 0)
-			{
-				return haystack + i;
-			}
-		}
+		if (needle_len == 1)
+			return static_cast<const u8*>(std::memchr(haystack, needle[0], haystack_len));
+
+		static const SearchFunction search = select_search_function();
 
-		return nullptr;
+		// Verification of candidates may compare up to four haystack lengths before switching to the two-way search
+		SearchState state{haystack, haystack_len, needle, needle_len, Math::max<usize>(haystack_len * 4, 256)};
+		return search(state);
 	}
 }// namespace Trinex
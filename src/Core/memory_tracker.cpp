@@ -0,0 +1,258 @@
+#include <Core/etl/atomic.hpp>
+#include <Core/etl/critical_section.hpp>
+#include <Core/math/math.hpp>
+#include <Core/memory_tracker.hpp>
+#include <new>
+
+namespace Trinex
+{
+	namespace
+	{
+		static constexpr usize s_tag_count = static_cast<usize>(MemoryTag::Count);
+
+		// Counters are written only by the owning thread, atomics make concurrent reads from end_frame well-defined
+		struct ThreadCounters {
+			Atomic<u64> allocations[s_tag_count]      = {};
+			Atomic<u64> allocated_bytes[s_tag_count]  = {};
+			Atomic<u64> temp_allocations[s_tag_count] = {};
+			Atomic<u64> temp_bytes[s_tag_count]       = {};
+			ThreadCounters* next                      = nullptr;
+			ThreadCounters* prev                      = nullptr;
+
+			static inline void add(Atomic<u64>& counter, u64 value)
+			{
+				counter.store(counter.load(etl::memory_order_relaxed) + value, etl::memory_order_relaxed);
+			}
+		};
+
+		struct Totals {
+			u64 allocations      = 0;
+			u64 allocated_bytes  = 0;
+			u64 temp_allocations = 0;
+			u64 temp_bytes       = 0;
+		};
+
+		struct TrackerState {
+			CriticalSection cs;
+			ThreadCounters* threads = nullptr;
+			Totals released[s_tag_count];
+			Totals last_frame[s_tag_count];
+			Totals frame[s_tag_count];
+
+			Atomic<i64> live_bytes[s_tag_count] = {};
+			Atomic<i64> peak_bytes[s_tag_count] = {};
+
+			Totals totals(usize tag)
+			{
+				Totals result = released[tag];
+
+				for (ThreadCounters* counters = threads; counters; counters = counters->next)
+				{
+					result.allocations += counters->allocations[tag].load(etl::memory_order_relaxed);
+					result.allocated_bytes += counters->allocated_bytes[tag].load(etl::memory_order_relaxed);
+					result.temp_allocations += counters->temp_allocations[tag].load(etl::memory_order_relaxed);
+					result.temp_bytes += counters->temp_bytes[tag].load(etl::memory_order_relaxed);
+				}
+
+				return result;
+			}
+		};
+
+		// State is never destroyed, allocations are tracked during static destruction too
+		static TrackerState& tracker_state()
+		{
+			alignas(TrackerState) static u8 storage[sizeof(TrackerState)];
+			static TrackerState* state = new (storage) TrackerState();
+			return *state;
+		}
+
+		static thread_local MemoryTag s_tag            = MemoryTag::Core;
+		static thread_local u64 s_thread_allocations   = 0;
+		static thread_local ThreadCounters* s_counters = nullptr;
+		static thread_local bool s_counters_released   = false;
+
+		struct ThreadCountersOwner {
+			ThreadCounters counters;
+
+			ThreadCountersOwner()
+			{
+				TrackerState& state = tracker_state();
+				ScopeLock lock(state.cs);
+
+				counters.next = state.threads;
+
+				if (state.threads)
+					state.threads->prev = &counters;
+
+				state.threads = &counters;
+			}
+
+			~ThreadCountersOwner()
+			{
+				s_counters          = nullptr;
+				s_counters_released = true;
+
+				TrackerState& state = tracker_state();
+				ScopeLock lock(state.cs);
+
+				for (usize tag = 0; tag < s_tag_count; ++tag)
+				{
+					state.released[tag].allocations += counters.allocations[tag].load(etl::memory_order_relaxed);
+					state.released[tag].allocated_bytes += counters.allocated_bytes[tag].load(etl::memory_order_relaxed);
+					state.released[tag].temp_allocations += counters.temp_allocations[tag].load(etl::memory_order_relaxed);
+					state.released[tag].temp_bytes += counters.temp_bytes[tag].load(etl::memory_order_relaxed);
+				}
+
+				if (counters.prev)
+					counters.prev->next = counters.next;
+				else
+					state.threads = counters.next;
+
+				if (counters.next)
+					counters.next->prev = counters.prev;
+			}
+		};
+
+		// Returns nullptr after the thread counters were destroyed, allocations of exiting threads are not tracked
+		static inline ThreadCounters* thread_counters()
+		{
+			if (s_counters || s_counters_released)
+				return s_counters;
+
+			static thread_local ThreadCountersOwner owner;
+			s_counters = &owner.counters;
+			return s_counters;
+		}
+	}// namespace
+
+	MemoryTracker::TagScope::TagScope(MemoryTag tag) : m_prev(s_tag)
+	{
+		s_tag = tag;
+	}
+
+	MemoryTracker::TagScope::~TagScope()
+	{
+		s_tag = m_prev;
+	}
+
+	MemoryTracker::AllocationScope::AllocationScope() : m_start(s_thread_allocations) {}
+
+	usize MemoryTracker::AllocationScope::allocations() const
+	{
+		return s_thread_allocations - m_start;
+	}
+
+	MemoryTracker::ExpectAllocations::ExpectAllocations(usize expected, const char* file, int line)
+	    : m_expected(expected), m_file(file), m_line(line)
+	{}
+
+	MemoryTracker::ExpectAllocations::~ExpectAllocations()
+	{
+		const usize count = allocations();
+
+		if (count != m_expected)
+		{
+			Asserts::report_failure_fmt("allocations() == expected", m_file, m_line, "trinex_expect_allocations",
+			                            "Expected %zu allocations in scope, but %zu were made", m_expected, count);
+		}
+	}
+
+	MemoryTag MemoryTracker::tag()
+	{
+		return s_tag;
+	}
+
+	const char* MemoryTracker::tag_name(MemoryTag tag)
+	{
+		switch (tag)
+		{
+			case MemoryTag::Core: return "Core";
+			case MemoryTag::Task: return "Task";
+			case MemoryTag::RHI: return "RHI";
+			case MemoryTag::Render: return "Render";
+			case MemoryTag::Script: return "Script";
+			case MemoryTag::Editor: return "Editor";
+			case MemoryTag::Asset: return "Asset";
+			default: return "Unknown";
+		}
+	}
+
+	MemoryTracker::Stats MemoryTracker::stats(MemoryTag tag)
+	{
+		const usize index   = static_cast<usize>(tag);
+		TrackerState& state = tracker_state();
+		Stats stats;
+
+		{
+			ScopeLock lock(state.cs);
+			Totals totals = state.totals(index);
+
+			stats.allocations       = totals.allocations;
+			stats.allocated_bytes   = totals.allocated_bytes;
+			stats.temp_allocations  = totals.temp_allocations;
+			stats.temp_bytes        = totals.temp_bytes;
+			stats.frame_allocations = state.frame[index].allocations;
+			stats.frame_bytes       = state.frame[index].allocated_bytes;
+		}
+
+		stats.live_bytes = Math::max<i64>(state.live_bytes[index].load(etl::memory_order_relaxed), 0);
+		stats.peak_bytes = Math::max<i64>(state.peak_bytes[index].load(etl::memory_order_relaxed), 0);
+		return stats;
+	}
+
+	void MemoryTracker::end_frame()
+	{
+		TrackerState& state = tracker_state();
+		ScopeLock lock(state.cs);
+
+		for (usize tag = 0; tag < s_tag_count; ++tag)
+		{
+			Totals totals = state.totals(tag);
+			Totals& last  = state.last_frame[tag];
+			Totals& frame = state.frame[tag];
+
+			frame.allocations      = totals.allocations - last.allocations;
+			frame.allocated_bytes  = totals.allocated_bytes - last.allocated_bytes;
+			frame.temp_allocations = totals.temp_allocations - last.temp_allocations;
+			frame.temp_bytes       = totals.temp_bytes - last.temp_bytes;
+			last                   = totals;
+		}
+	}
+
+	void MemoryTracker::on_allocate(usize size)
+	{
+		++s_thread_allocations;
+
+		if (ThreadCounters* counters = thread_counters())
+		{
+			const usize tag = static_cast<usize>(s_tag);
+			ThreadCounters::add(counters->allocations[tag], 1);
+			ThreadCounters::add(counters->allocated_bytes[tag], size);
+		}
+	}
+
+	void MemoryTracker::on_temp_allocate(usize size)
+	{
+		if (ThreadCounters* counters = thread_counters())
+		{
+			const usize tag = static_cast<usize>(s_tag);
+			ThreadCounters::add(counters->temp_allocations[tag], 1);
+			ThreadCounters::add(counters->temp_bytes[tag], size);
+		}
+	}
+
+	void MemoryTracker::on_live_allocate(MemoryTag tag, usize size)
+	{
+		TrackerState& state = tracker_state();
+		const usize index   = static_cast<usize>(tag);
+		const i64 live      = state.live_bytes[index].fetch_add(size, etl::memory_order_relaxed) + static_cast<i64>(size);
+		i64 peak            = state.peak_bytes[index].load(etl::memory_order_relaxed);
+
+		while (peak < live && !state.peak_bytes[index].compare_exchange_weak(peak, live, etl::memory_order_relaxed)) {}
+	}
+
+	void MemoryTracker::on_live_deallocate(MemoryTag tag, usize size)
+	{
+		tracker_state().live_bytes[static_cast<usize>(tag)].fetch_sub(size, etl::memory_order_relaxed);
+	}
+}// namespace Trinex
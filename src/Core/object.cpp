@@ -3,12 +3,19 @@
 #include <Core/buffer_manager.hpp>
 #include <Core/compressor.hpp>
 #include <Core/constants.hpp>
+#include <Core/coroutine.hpp>
+#include <Core/etl/critical_section.hpp>
+#include <Core/etl/map.hpp>
+#include <Core/etl/set.hpp>
 #include <Core/etl/templates.hpp>
 #include <Core/file_flag.hpp>
 #include <Core/file_manager.hpp>
 #include <Core/filesystem/root_filesystem.hpp>
+#include <Core/garbage_collector.hpp>
 #include <Core/memory.hpp>
+#include <Core/memory_tracker.hpp>
 #include <Core/object.hpp>
+#include <Core/object_handle.hpp>
 #include <Core/object_listener.hpp>
 #include <Core/package.hpp>
 #include <Core/pointer.hpp>
@@ -40,6 +47,72 @@ namespace Trinex
 	static Vector<Object*> s_root_objects;
 	static Vector<Object*> s_objects;
 
+	// Cache of the objects resolved by static_find_object. Entries are keyed by the hash of the requested path,
+	// detaching a cached object from its owner or destroying it removes the entry. Detaching an owner of a cached
+	// object changes the path of all objects below it, so the whole cache is dropped in this case
+	static struct ObjectPathIndex {
+		struct Entry {
+			Object* object;
+			String path;
+		};
+
+		CriticalSection m_cs;
+		Map<u64, Entry> m_entries;
+		Map<Object*, u64> m_keys;
+		Set<Object*> m_owners;
+
+		static inline u64 hash_of(StringView path) { return static_cast<u64>(memory_hash_fast(path.data(), path.size())); }
+
+		Object* find(StringView path)
+		{
+			ScopeLock lock(m_cs);
+			auto it = m_entries.find(hash_of(path));
+
+			if (it != m_entries.end() && it->second.path == path)
+				return it->second.object;
+
+			return nullptr;
+		}
+
+		void insert(StringView path, Object* object)
+		{
+			ScopeLock lock(m_cs);
+			const u64 key = hash_of(path);
+
+			// Objects are cached by the first resolved path only, so that eviction needs a single lookup
+			if (m_keys.contains(object) || m_entries.contains(key))
+				return;
+
+			m_entries.insert({key, Entry{object, String(path)}});
+			m_keys.insert({object, key});
+
+			Object* owner = object->owner();
+
+			while (owner && m_owners.insert(owner).second) owner = owner->owner();
+		}
+
+		void evict(Object* object)
+		{
+			ScopeLock lock(m_cs);
+
+			if (m_owners.contains(object))
+			{
+				m_entries.clear();
+				m_keys.clear();
+				m_owners.clear();
+				return;
+			}
+
+			auto it = m_keys.find(object);
+
+			if (it != m_keys.end())
+			{
+				m_entries.erase(it->second);
+				m_keys.erase(it);
+			}
+		}
+	} s_path_index;
+
 	static void create_default_package()
 	{
 		if (s_root_package == nullptr)
@@ -61,6 +134,15 @@ namespace Trinex
 		return s_next_object_info.class_instance;
 	}
 
+	void* Object::static_allocate_pooled_instance(Refl::Class* self, usize size, usize alignment)
+	{
+		// Pooled memory is returned by destroy_object of the object class, so it must be the same class as the pool owner
+		if (s_next_object_info.class_instance != self)
+			return nullptr;
+
+		return self->allocate_pooled_instance(size, alignment);
+	}
+
 	void Object::initialize_new_object(Object* object, StringView name, Object* owner)
 	{
 		object->m_name = name;
@@ -94,6 +176,27 @@ namespace Trinex
 			ScriptNamespaceScopedChanger changer("Trinex::Object");
 			ScriptEngine::register_function("Object@ static_find_object(StringView object_name)", static_find_object);
 		}
+
+		{
+			auto flags  = ScriptClassFlags::Pod | ScriptClassFlags::AppClassAllInts | ScriptClassFlags::AppClassMoreConstructors;
+			auto handle = ScriptBinding::Class::create("Trinex::ObjectHandle", ScriptBinding::value_type<ObjectHandle>(flags));
+
+			handle.behaviour(ScriptClassBehave::Construct, "void f()", ScriptBinding::Helpers::constructor<ObjectHandle>,
+			                 ScriptCallConv::CDeclObjFirst);
+			handle.behaviour(ScriptClassBehave::Construct, "void f(Object@ object)",
+			                 ScriptBinding::Helpers::constructor<ObjectHandle, const Object*>, ScriptCallConv::CDeclObjFirst);
+
+			handle.method("Object@ object() const", static_cast<Object* (ObjectHandle::*) () const>(&ObjectHandle::object));
+			handle.method("bool is_valid() const", &ObjectHandle::is_valid);
+			handle.method("Trinex::ObjectHandle& reset()", &ObjectHandle::reset);
+			handle.method("uint32 index() const", &ObjectHandle::index);
+			handle.method("uint32 generation() const", &ObjectHandle::generation);
+			handle.method("Trinex::ObjectHandle& opAssign(Object@ object)",
+			              static_cast<ObjectHandle& (ObjectHandle::*) (const Object*)>(&ObjectHandle::operator=));
+			handle.method("bool opEquals(const Trinex::ObjectHandle&) const", &ObjectHandle::operator==);
+
+			r.method("Trinex::ObjectHandle handle() const final", &Object::handle);
+		}
 	}
 
 	void Object::script_preload()
@@ -153,7 +256,7 @@ namespace Trinex
 		return 0;
 	}
 
-	Object::Object() : m_references(0)
+	Object::Object() : m_references(0), m_gc_epoch(0)
 	{
 		trinex_verify_msg(s_next_object_info.class_instance, "Next object class is invalid!");
 
@@ -168,6 +271,9 @@ namespace Trinex
 
 		m_global_index = s_objects.size();
 		s_objects.push_back(this);
+
+		m_handle_index = ObjectHandle::allocate_slot(this);
+		GarbageCollector::on_object_created(this);
 	}
 
 	class Refl::Class* Object::class_instance() const
@@ -220,6 +326,7 @@ namespace Trinex
 	Object::~Object()
 	{
 		remove_from<&Object::m_global_index>(s_objects, m_global_index);
+		ObjectHandle::release_slot(m_handle_index);
 	}
 
 	const String& Object::string_name() const
@@ -377,7 +484,21 @@ namespace Trinex
 
 	ENGINE_EXPORT Object* Object::static_find_object(StringView object_name)
 	{
-		return s_root_package->find_child_object(object_name);
+		if (Object* object = s_path_index.find(object_name))
+		{
+			GarbageCollector::write_barrier(object);
+			return object;
+		}
+
+		Object* object = s_root_package->find_child_object(object_name);
+
+		if (object)
+		{
+			s_path_index.insert(object_name, object);
+			GarbageCollector::write_barrier(object);
+		}
+
+		return object;
 	}
 
 	Object& Object::preload()
@@ -402,6 +523,8 @@ namespace Trinex
 
 	Object& Object::on_destroy()
 	{
+		s_path_index.evict(this);
+
 		if (m_owner)
 		{
 			m_owner->unregister_child(this);
@@ -439,6 +562,8 @@ namespace Trinex
 
 		if (m_owner)
 		{
+			s_path_index.evict(this);
+
 			if (!m_owner->unregister_child(this))
 			{
 				trinex_error(Log::Core, "Failed to unregister object from prev owner!");
@@ -483,6 +608,10 @@ namespace Trinex
 			}
 		}
 
+		// The new owner keeps this object alive, so its references must be scanned in the current cycle
+		if (m_owner)
+			GarbageCollector::write_barrier(this);
+
 		on_owner_update(m_owner);
 		return true;
 	}
@@ -529,6 +658,11 @@ namespace Trinex
 		return m_global_index;
 	}
 
+	ObjectHandle Object::handle() const
+	{
+		return ObjectHandle(this);
+	}
+
 	bool Object::serialize(Archive& archive)
 	{
 		if (!flags.any(Flags::IsSerializable))
@@ -619,7 +753,11 @@ namespace Trinex
 		Vector<u8> raw_buffer;
 		VectorWriter raw_writer = &raw_buffer;
 		Archive raw             = &raw_writer;
-		raw.flags               = serialization_flags;
+		Archive::ImportTable imports;
+		Archive::SchemaTable schemas;
+		raw.flags   = serialization_flags;
+		raw.imports = &imports;
+		raw.schemas = &schemas;
 
 		{
 			Object* self = this;
@@ -643,8 +781,10 @@ namespace Trinex
 			return false;
 
 		Archive ar(writer);
-		FileFlag flag = FileFlag::asset_flag();
+		FileFlag flag = FileFlag::asset_schemas_flag();
 		ar.serialize(flag);
+		ar.serialize(imports.paths);
+		ar.serialize(schemas.schemas);
 		ar.serialize(compressed_buffer);
 
 		if (need_destroy_writer)
@@ -655,43 +795,232 @@ namespace Trinex
 		return ar;
 	}
 
-	ENGINE_EXPORT Object* Object::load_object(StringView fullname, class BufferReader* reader,
-	                                          SerializationFlags serialization_flags)
+	struct AssetData {
+		Vector<u8> raw;
+		Vector<String> imports;
+		Vector<Archive::SchemaTable::Schema> schemas;
+		bool has_import_table = false;// Legacy assets store references by name
+		bool has_schema_table = false;// Legacy assets store properties with names
+	};
+
+	static Path asset_path_of(StringView name)
 	{
-		if (reader == nullptr)
+		return Path(Project::assets_dir) /
+		       Path(Strings::replace_all(name, Constants::name_separator, Path::sv_separator) + Constants::asset_extention);
+	}
+
+	static bool read_asset_data(BufferReader* reader, AssetData& data)
+	{
+		trinex_memory_tag(Asset);
+
+		Archive ar(reader);
+		FileFlag flag;
+		ar.serialize(flag);
+
+		if (flag == FileFlag::asset_imports_flag() || flag == FileFlag::asset_schemas_flag())
 		{
-			trinex_error(Log::Core, "Cannot load object from nullptr buffer reader!");
-			return nullptr;
+			data.has_import_table = true;
+
+			if (!ar.serialize(data.imports))
+			{
+				trinex_error(Log::Core, "Failed to read import table!");
+				return false;
+			}
+
+			if (flag == FileFlag::asset_schemas_flag())
+			{
+				data.has_schema_table = true;
+
+				if (!ar.serialize(data.schemas))
+				{
+					trinex_error(Log::Core, "Failed to read schema table!");
+					return false;
+				}
+			}
+		}
+		else if (flag != FileFlag::asset_flag())
+		{
+			trinex_error(Log::Core, "Cannot load object. Asset flag mismatch!");
+			return false;
 		}
 
-		if (!(serialization_flags & SerializationFlags::SkipObjectSearch))
+		// Compressed data is stored as Vector<u8>. Readers which keep the file in memory give access to the data directly,
+		// so it is decompressed without copying it into an intermediate buffer
+		usize compressed_size = 0;
+		if (!ar.serialize(compressed_size))
 		{
-			if (Object* object = static_find_object(fullname))
+			trinex_error(Log::Core, "Failed to read compressed buffer!");
+			return false;
+		}
+
+		if (const u8* compressed = reader->read_view(compressed_size))
+		{
+			Compressor::decompress(compressed, compressed_size, data.raw);
+			return true;
+		}
+
+		Vector<u8> compressed_buffer(compressed_size);
+		if (!reader->read(compressed_buffer.data(), compressed_size))
+		{
+			trinex_error(Log::Core, "Failed to read compressed buffer!");
+			return false;
+		}
+
+		Compressor::decompress(compressed_buffer, data.raw);
+		return true;
+	}
+
+	// Native files are mapped into memory, files of other file systems are read through the file system
+	static bool read_asset_file(const Path& path, AssetData& data)
+	{
+		MappedFileReader mapped(path);
+
+		if (mapped.is_open())
+			return read_asset_data(&mapped, data);
+
+		FileReader reader(path);
+		return reader.is_open() && read_asset_data(&reader, data);
+	}
+
+	// Dependencies which are read ahead of the objects referencing them. load_object takes the entry when the reference
+	// is resolved, entries which were never taken are dropped by the load which has read them
+	static struct ImportCache {
+		CriticalSection m_cs;
+		Map<String, AssetData> m_entries;
+
+		bool contains(const String& name)
+		{
+			ScopeLock lock(m_cs);
+			return m_entries.contains(name);
+		}
+
+		void insert(const String& name, AssetData&& data)
+		{
+			ScopeLock lock(m_cs);
+			m_entries.insert({name, std::move(data)});
+		}
+
+		bool take(const String& name, AssetData& data)
+		{
+			ScopeLock lock(m_cs);
+			auto it = m_entries.find(name);
+
+			if (it == m_entries.end())
+				return false;
+
+			data = std::move(it->second);
+			m_entries.erase(it);
+			return true;
+		}
+
+		void erase(const Vector<String>& names)
+		{
+			ScopeLock lock(m_cs);
+
+			for (const String& name : names)
 			{
-				return object;
+				m_entries.erase(name);
 			}
 		}
+	} s_import_cache;
+
+	// Reads dependencies of an asset breadth first, all files of the level are read in parallel on TaskGraph workers.
+	// Loaded objects are searched on the logic thread, so that read() is the only step which may run on a worker.
+	// Prefetched data stays in the import cache until the root is deserialized, so the next level isn't collected after
+	// s_max_prefetch_size bytes are cached, the remaining dependencies are read when their references are resolved
+	struct ImportPrefetcher {
+		static constexpr usize s_max_prefetch_size = 64 * 1024 * 1024;
+
+		Set<String> visited;
+		Vector<String> level;
+		Vector<AssetData> assets;
+		Vector<u8> is_read;
+		Vector<String> prefetched;
+		usize prefetched_size = 0;
+
+		ImportPrefetcher(StringView root)
+		{
+			// The root is deserialized from its own buffer, an import cycle back to it mustn't read the file again
+			if (!root.empty())
+				visited.insert(String(root));
+		}
 
-		Archive ar(reader);
-		FileFlag flag = FileFlag::asset_flag();
-		ar.serialize(flag);
-		if (flag != FileFlag::asset_flag())
+		void collect(const AssetData& data)
 		{
-			trinex_error(Log::Core, "Cannot load object. Asset flag mismatch!");
-			return nullptr;
+			for (const String& name : data.imports)
+			{
+				if (!visited.insert(name).second)
+					continue;
+
+				if (Object::static_find_object(name) || s_import_cache.contains(name))
+					continue;
+
+				// Missing files are reported by load_object when the reference is resolved
+				if (!rootfs()->is_file(asset_path_of(name)))
+					continue;
+
+				level.push_back(name);
+			}
 		}
 
-		Vector<u8> compressed_buffer;
-		if (!(ar.serialize(compressed_buffer)))
+		void read()
 		{
-			trinex_error(Log::Core, "Failed to read compressed buffer!");
-			return nullptr;
+			assets.clear();
+			assets.resize(level.size());
+			is_read.assign(level.size(), 0);
+
+			auto read_import = [this](usize index) {
+				is_read[index] = read_asset_file(asset_path_of(level[index]), assets[index]);
+			};
+
+			TaskGraph::instance()->for_each(level.size(), read_import, 1);
+		}
+
+		void advance()
+		{
+			Vector<String> current = std::move(level);
+			level.clear();
+
+			for (usize index = 0; index < current.size(); ++index)
+			{
+				if (!is_read[index])
+					continue;
+
+				if (prefetched_size < s_max_prefetch_size)
+					collect(assets[index]);
+
+				prefetched_size += assets[index].raw.size();
+				s_import_cache.insert(current[index], std::move(assets[index]));
+				prefetched.push_back(std::move(current[index]));
+			}
+
+			assets.clear();
+			is_read.clear();
 		}
 
-		Vector<u8> raw_data;
-		Compressor::decompress(compressed_buffer, raw_data);
-		VectorReader raw_reader = &raw_data;
+		~ImportPrefetcher() { s_import_cache.erase(prefetched); }
+	};
+
+	static Object* deserialize_asset(StringView fullname, AssetData& data)
+	{
+		trinex_memory_tag(Asset);
+
+		VectorReader raw_reader = &data.raw;
 		Archive raw             = &raw_reader;
+		Archive::ImportTable imports;
+		Archive::SchemaTable schemas;
+
+		if (data.has_import_table)
+		{
+			imports.paths = std::move(data.imports);
+			raw.imports   = &imports;
+		}
+
+		if (data.has_schema_table)
+		{
+			schemas.schemas = std::move(data.schemas);
+			raw.schemas     = &schemas;
+		}
 
 		Object* object = nullptr;
 
@@ -710,8 +1039,52 @@ namespace Trinex
 		return object;
 	}
 
+	static Object* load_asset(StringView fullname, AssetData& data)
+	{
+		ImportPrefetcher prefetcher(fullname);
+		prefetcher.collect(data);
+
+		while (!prefetcher.level.empty())
+		{
+			prefetcher.read();
+			prefetcher.advance();
+		}
+
+		return deserialize_asset(fullname, data);
+	}
+
+	ENGINE_EXPORT Object* Object::load_object(StringView fullname, class BufferReader* reader,
+	                                          SerializationFlags serialization_flags)
+	{
+		if (reader == nullptr)
+		{
+			trinex_error(Log::Core, "Cannot load object from nullptr buffer reader!");
+			return nullptr;
+		}
+
+		if (!(serialization_flags & SerializationFlags::SkipObjectSearch))
+		{
+			if (Object* object = static_find_object(fullname))
+			{
+				return object;
+			}
+		}
+
+		AssetData data;
+
+		if (!read_asset_data(reader, data))
+			return nullptr;
+
+		return load_asset(fullname, data);
+	}
+
 	static Object* load_from_file_internal(const Path& path, StringView fullname, SerializationFlags flags)
 	{
+		MappedFileReader mapped(path);
+
+		if (mapped.is_open())
+			return Object::load_object(fullname, &mapped, flags);
+
 		FileReader reader(path);
 		if (reader.is_open())
 		{
@@ -730,9 +1103,54 @@ namespace Trinex
 				return object;
 		}
 
-		Path path = Path(Project::assets_dir) /
-		            Path(Strings::replace_all(name, Constants::name_separator, Path::sv_separator) + Constants::asset_extention);
-		return load_from_file_internal(path, name, flags | SerializationFlags::SkipObjectSearch);
+		AssetData data;
+
+		if (s_import_cache.take(String(name), data))
+			return load_asset(name, data);
+
+		return load_from_file_internal(asset_path_of(name), name, flags | SerializationFlags::SkipObjectSearch);
+	}
+
+	ENGINE_EXPORT Coroutine<Object*> Object::load_object_async(String name, SerializationFlags flags)
+	{
+		const bool search = !(flags & SerializationFlags::SkipObjectSearch);
+
+		if (search)
+		{
+			if (Object* object = static_find_object(name))
+				co_return object;
+		}
+
+		const Path path = asset_path_of(name);
+		AssetData data;
+		bool is_read = false;
+
+		co_await resume_on(TaskGraph::instance());
+		is_read = read_asset_file(path, data);
+		co_await resume_on(logic_thread());
+
+		if (!is_read)
+			co_return nullptr;
+
+		// The same object could be loaded by someone else while the file was read
+		if (search)
+		{
+			if (Object* object = static_find_object(name))
+				co_return object;
+		}
+
+		ImportPrefetcher prefetcher(name);
+		prefetcher.collect(data);
+
+		while (!prefetcher.level.empty())
+		{
+			co_await resume_on(TaskGraph::instance());
+			prefetcher.read();
+			co_await resume_on(logic_thread());
+			prefetcher.advance();
+		}
+
+		co_return deserialize_asset(name, data);
 	}
 
 	ENGINE_EXPORT Object* Object::load_object_from_file(const Path& path, SerializationFlags flags)
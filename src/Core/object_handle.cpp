@@ -0,0 +1,159 @@
+#include <Core/etl/allocator.hpp>
+#include <Core/etl/atomic.hpp>
+#include <Core/etl/critical_section.hpp>
+#include <Core/object_handle.hpp>
+
+namespace Trinex
+{
+	namespace
+	{
+		// Slots are allocated in chunks which are never moved or freed, so resolving a handle needs no locks.
+		// Released slots are reused in LIFO order with an incremented generation
+		class ObjectSlotTable
+		{
+		private:
+			static constexpr u32 s_chunk_bits = 12;
+			static constexpr u32 s_chunk_size = 1 << s_chunk_bits;
+			static constexpr u32 s_max_chunks = 1 << 14;
+
+			struct Slot {
+				Atomic<Object*> object;
+				Atomic<u32> generation;
+				u32 next_free;
+			};
+
+			CriticalSection m_cs;
+			Atomic<Slot*> m_chunks[s_max_chunks] = {};
+			Atomic<u32> m_count                  = 0;
+			u32 m_free                           = ObjectHandle::invalid_index;
+
+			FORCE_INLINE Slot* slot(u32 index) const
+			{
+				return m_chunks[index >> s_chunk_bits].load(etl::memory_order_acquire) + (index & (s_chunk_size - 1));
+			}
+
+		public:
+			static ObjectSlotTable& instance()
+			{
+				// Objects can be destroyed by static destructors, so the table is never destroyed
+				alignas(ObjectSlotTable) static u8 storage[sizeof(ObjectSlotTable)];
+				static ObjectSlotTable* table = new (storage) ObjectSlotTable();
+				return *table;
+			}
+
+			u32 allocate(Object* object)
+			{
+				ScopeLock lock(m_cs);
+				u32 index = m_free;
+
+				if (index != ObjectHandle::invalid_index)
+				{
+					m_free = slot(index)->next_free;
+				}
+				else
+				{
+					index = m_count.load(etl::memory_order_relaxed);
+					trinex_verify_msg(index < s_chunk_size * s_max_chunks, "Object slots limit exceeded");
+
+					if ((index & (s_chunk_size - 1)) == 0)
+					{
+						auto memory = ByteAllocator::allocate_aligned(sizeof(Slot) * s_chunk_size, alignof(Slot));
+						auto chunk  = reinterpret_cast<Slot*>(memory);
+
+						for (u32 i = 0; i < s_chunk_size; ++i) new (chunk + i) Slot{nullptr, 1, ObjectHandle::invalid_index};
+						m_chunks[index >> s_chunk_bits].store(chunk, etl::memory_order_release);
+					}
+
+					m_count.store(index + 1, etl::memory_order_release);
+				}
+
+				slot(index)->object.store(object, etl::memory_order_release);
+				return index;
+			}
+
+			void release(u32 index)
+			{
+				ScopeLock lock(m_cs);
+				Slot* current = slot(index);
+
+				// Generation zero is never used, so that the default handle never matches a slot
+				u32 generation = current->generation.load(etl::memory_order_relaxed) + 1;
+				current->generation.store(generation == 0 ? 1 : generation, etl::memory_order_release);
+				current->object.store(nullptr, etl::memory_order_release);
+
+				current->next_free = m_free;
+				m_free             = index;
+			}
+
+			inline u32 count() const { return m_count.load(etl::memory_order_acquire); }
+
+			inline u32 generation(u32 index) const { return slot(index)->generation.load(etl::memory_order_acquire); }
+
+			inline Object* find(u32 index, u32 generation) const
+			{
+				if (index >= count())
+					return nullptr;
+
+				Slot* current = slot(index);
+				Object* found = current->object.load(etl::memory_order_acquire);
+
+				return current->generation.load(etl::memory_order_acquire) == generation ? found : nullptr;
+			}
+
+			inline Object* find(u32 index) const
+			{
+				return index < count() ? slot(index)->object.load(etl::memory_order_acquire) : nullptr;
+			}
+		};
+	}// namespace
+
+	u32 ObjectHandle::allocate_slot(Object* object)
+	{
+		return ObjectSlotTable::instance().allocate(object);
+	}
+
+	void ObjectHandle::release_slot(u32 index)
+	{
+		ObjectSlotTable::instance().release(index);
+	}
+
+	ObjectHandle::ObjectHandle(const Object* object)
+	{
+		*this = object;
+	}
+
+	ObjectHandle& ObjectHandle::operator=(const Object* object)
+	{
+		if (object)
+		{
+			m_index      = object->m_handle_index;
+			m_generation = ObjectSlotTable::instance().generation(m_index);
+		}
+		else
+		{
+			reset();
+		}
+
+		return *this;
+	}
+
+	Object* ObjectHandle::object() const
+	{
+		return ObjectSlotTable::instance().find(m_index, m_generation);
+	}
+
+	bool ObjectHandle::is_valid() const
+	{
+		return object() != nullptr;
+	}
+
+	u32 ObjectHandle::static_slots_count()
+	{
+		return ObjectSlotTable::instance().count();
+	}
+
+	Object* ObjectHandle::static_find_object(u32 index)
+	{
+		return ObjectSlotTable::instance().find(index);
+	}
+}// namespace Trinex
@@ -1,5 +1,6 @@
 #include <Core/archive.hpp>
 #include <Core/base_engine.hpp>
+#include <Core/garbage_collector.hpp>
 #include <Core/object.hpp>
 #include <Core/pointer.hpp>
 
@@ -18,6 +19,7 @@ namespace Trinex
 		if (object && can_update_reference())
 		{
 			++object->m_references;
+			GarbageCollector::write_barrier(object);
 		}
 		return *this;
 	}
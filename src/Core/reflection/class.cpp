@@ -1,4 +1,9 @@
+#include <Core/etl/algorithm.hpp>
+#include <Core/etl/allocator.hpp>
+#include <Core/etl/critical_section.hpp>
 #include <Core/garbage_collector.hpp>
+#include <Core/math/math.hpp>
+#include <Core/memory.hpp>
 #include <Core/reflection/class.hpp>
 #include <Core/string_functions.hpp>
 #include <ScriptEngine/script_binding.hpp>
@@ -26,6 +31,123 @@ namespace Trinex::Refl
 		return vector;
 	}
 
+	static FORCE_INLINE Vector<Class*>& get_pooled_class_table()
+	{
+		static Vector<Class*> vector;
+		return vector;
+	}
+
+	// Objects of a pooled class are placed into fixed size slots of large slabs, so instances of one class stay close in memory.
+	// Slabs are never returned to ByteAllocator while the class is alive, freed slots are reused by the next allocations
+	class Class::Pool
+	{
+	private:
+		static constexpr usize s_slab_size = 64 * 1024;
+		static constexpr usize s_min_slots = 16;
+
+		struct FreeSlot {
+			FreeSlot* next;
+		};
+
+		mutable CriticalSection m_cs;
+		Vector<u8*> m_slabs;// Sorted by address
+		FreeSlot* m_free = nullptr;
+		usize m_object_size;
+		usize m_alignment;
+		usize m_slot_size;
+		usize m_slab_bytes;
+		PoolStatistics m_stats;
+
+		void allocate_slab()
+		{
+			u8* slab = ByteAllocator::allocate_aligned(m_slab_bytes, m_alignment);
+			m_slabs.insert(etl::upper_bound(m_slabs.begin(), m_slabs.end(), slab), slab);
+
+			// Slots are linked in reverse order, so that the new slab is filled from the beginning
+			for (usize offset = m_slab_bytes; offset >= m_slot_size; offset -= m_slot_size)
+			{
+				FreeSlot* slot = reinterpret_cast<FreeSlot*>(slab + offset - m_slot_size);
+				slot->next     = m_free;
+				m_free         = slot;
+			}
+
+			++m_stats.slabs;
+			m_stats.reserved_bytes += m_slab_bytes;
+		}
+
+		bool contains(const void* object) const
+		{
+			const u8* address = static_cast<const u8*>(object);
+			auto it           = etl::upper_bound(m_slabs.begin(), m_slabs.end(), address);
+
+			if (it == m_slabs.begin())
+				return false;
+
+			--it;
+			return address < *it + m_slab_bytes;
+		}
+
+	public:
+		Pool(usize size, usize alignment)
+		    : m_object_size(size), m_alignment(Math::max<usize>(alignment, alignof(FreeSlot))),
+		      m_slot_size(align_up(Math::max(size, sizeof(FreeSlot)), m_alignment))
+		{
+			const usize slots = Math::max(s_slab_size / m_slot_size, s_min_slots);
+			m_slab_bytes      = slots * m_slot_size;
+			m_stats.slot_size = m_slot_size;
+		}
+
+		void* allocate(usize size, usize alignment)
+		{
+			if (size != m_object_size || alignment > m_alignment)
+				return nullptr;
+
+			ScopeLock lock(m_cs);
+
+			if (m_free == nullptr)
+				allocate_slab();
+
+			FreeSlot* slot = m_free;
+			m_free         = slot->next;
+
+			++m_stats.allocations;
+			m_stats.peak_objects = Math::max(++m_stats.live_objects, m_stats.peak_objects);
+			return slot;
+		}
+
+		bool owns(const void* object) const
+		{
+			ScopeLock lock(m_cs);
+			return contains(object);
+		}
+
+		void deallocate(void* object)
+		{
+			ScopeLock lock(m_cs);
+			trinex_assert(contains(object));
+
+			FreeSlot* slot = static_cast<FreeSlot*>(object);
+			slot->next     = m_free;
+			m_free         = slot;
+			--m_stats.live_objects;
+		}
+
+		PoolStatistics statistics() const
+		{
+			ScopeLock lock(m_cs);
+			return m_stats;
+		}
+
+		~Pool()
+		{
+			// Objects which are still alive keep their slabs, it's cheaper to leak them than to crash on shutdown
+			if (m_stats.live_objects != 0)
+				return;
+
+			for (u8* slab : m_slabs) ByteAllocator::deallocate(slab);
+		}
+	};
+
 	Class::Class(Class* parent, BitMask flags) : Struct(parent, flags)
 	{
 		m_singletone_object = nullptr;
@@ -36,6 +158,16 @@ namespace Trinex::Refl
 		}
 	}
 
+	Class::~Class()
+	{
+		if (m_pool)
+		{
+			auto& table = get_pooled_class_table();
+			table.erase(etl::remove(table.begin(), table.end(), this), table.end());
+			trx_delete m_pool;
+		}
+	}
+
 	Class& Class::register_scriptable_instance()
 	{
 		auto registrar = ScriptBinding::Class::reflected(this);
@@ -59,6 +191,12 @@ namespace Trinex::Refl
 	{
 		Super::initialize();
 
+		if (flags.all(IsPooled | IsNative | IsConstructible) && m_pool == nullptr)
+		{
+			m_pool = trx_new Pool(size(), alignment());
+			get_pooled_class_table().push_back(this);
+		}
+
 		if (is_scriptable() && is_native())
 		{
 			auto registrar = ScriptBinding::Class::existing(full_name());
@@ -138,8 +276,20 @@ namespace Trinex::Refl
 		return object;
 	}
 
+	void* Class::allocate_pooled_instance(usize size, usize alignment)
+	{
+		return m_pool ? m_pool->allocate(size, alignment) : nullptr;
+	}
+
 	Class& Class::destroy_object(Trinex::Object* object)
 	{
+		if (m_pool && m_pool->owns(object))
+		{
+			object->~Object();
+			m_pool->deallocate(object);
+			return *this;
+		}
+
 		trx_delete object;
 		return *this;
 	}
@@ -161,6 +311,21 @@ namespace Trinex::Refl
 		return get_asset_class_table();
 	}
 
+	const Vector<Class*>& Class::pooled_classes()
+	{
+		return get_pooled_class_table();
+	}
+
+	bool Class::is_pooled() const
+	{
+		return m_pool != nullptr;
+	}
+
+	Class::PoolStatistics Class::pool_statistics() const
+	{
+		return m_pool ? m_pool->statistics() : PoolStatistics();
+	}
+
 	void Class::register_layout(ScriptBinding::Class& r, ClassInfo* info, DownCast downcast)
 	{
 		Super::register_layout(r, info, downcast);
@@ -1,5 +1,6 @@
 #include <Core/archive.hpp>
 #include <Core/etl/templates.hpp>
+#include <Core/garbage_collector.hpp>
 #include <Core/reflection/class.hpp>
 #include <Core/reflection/enum.hpp>
 #include <Core/reflection/property.hpp>
@@ -99,6 +100,11 @@ namespace Trinex::Refl
 		return *this;
 	}
 
+	isize Property::offset() const
+	{
+		return -1;
+	}
+
 	void Property::register_layout(ScriptBinding::Class& r, ClassInfo* info, DownCast downcast)
 	{
 		Super::register_layout(r, info, downcast);
@@ -215,6 +221,7 @@ namespace Trinex::Refl
 		if (object == nullptr || object->class_instance()->is_a(class_instance()))
 		{
 			(*address_as<Trinex::Object*>(context)) = object;
+			GarbageCollector::write_barrier(object);
 			return true;
 		}
 		return false;
@@ -1,4 +1,5 @@
 #include <Core/reflection/scoped_type.hpp>
+#include <Core/reflection/struct.hpp>
 #include <Core/string_functions.hpp>
 #include <ScriptEngine/script_binding.hpp>
 
@@ -51,6 +52,12 @@ namespace Trinex::Refl
 		{
 			load_childs_reflection(root, force_recursive);
 		}
+
+		if (root == static_root())
+		{
+			// Most of the structs are registered at this point, give them compact intervals with fresh room for script classes
+			Struct::update_hierarchy_order();
+		}
 	}
 
 	ScopedType& ScopedType::unregister_subobject(Object* subobject)
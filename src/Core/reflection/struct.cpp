@@ -1,7 +1,9 @@
 #include <Core/archive.hpp>
+#include <Core/etl/critical_section.hpp>
 #include <Core/group.hpp>
 #include <Core/reflection/property.hpp>
 #include <Core/reflection/struct.hpp>
+#include <Core/string_functions.hpp>
 #include <ScriptEngine/script_binding.hpp>
 
 #include <Graphics/gpu_buffers.hpp>
@@ -16,12 +18,109 @@ namespace Trinex::Refl
 		r.static_function("Struct@ static_require(StringView name, int flags = 0)", Struct::static_require<Struct>);
 	}
 
+	namespace
+	{
+		// Every struct numbered without a full renumbering reserves room for this count of derived structs
+		static constexpr u32 s_order_slack = 16;
+
+		struct HierarchyOrder {
+			CriticalSection cs;
+			Vector<Struct*> roots;
+			u32 next_root = 1;
+		};
+
+		static HierarchyOrder& hierarchy_order()
+		{
+			static HierarchyOrder order;
+			return order;
+		}
+	}// namespace
+
+	Atomic<u32> Struct::s_order_sequence = 0;
+
 	Struct::Struct(Struct* parent, BitMask flags) : flags(flags), m_parent(parent)
 	{
 		if (parent)
 		{
 			parent->m_derived_structs.insert(this);
 		}
+
+		insert_into_order();
+	}
+
+	u32 Struct::assign_order(u32 begin)
+	{
+		u32 count = 1;
+		u32 next  = begin + 1;
+
+		for (Struct* derived : m_derived_structs)
+		{
+			count += derived->assign_order(next);
+			next = derived->m_order_end.load(etl::memory_order_relaxed);
+		}
+
+		m_order_next = next;
+		m_order_begin.store(begin, etl::memory_order_relaxed);
+		m_order_end.store(next + std::max(s_order_slack, count), etl::memory_order_relaxed);
+		return count;
+	}
+
+	void Struct::insert_into_order()
+	{
+		HierarchyOrder& order = hierarchy_order();
+		ScopeLock lock(order.cs);
+
+		if (m_parent == nullptr)
+		{
+			order.roots.push_back(this);
+
+			m_order_next = order.next_root + 1;
+			m_order_begin.store(order.next_root, etl::memory_order_relaxed);
+			m_order_end.store(order.next_root + s_order_slack, etl::memory_order_relaxed);
+			order.next_root += s_order_slack;
+			return;
+		}
+
+		const u32 parent_begin = m_parent->m_order_begin.load(etl::memory_order_relaxed);
+		const u32 parent_end   = m_parent->m_order_end.load(etl::memory_order_relaxed);
+
+		if (parent_begin != 0 && m_parent->m_order_next + s_order_slack <= parent_end)
+		{
+			const u32 begin = m_parent->m_order_next;
+			m_parent->m_order_next += s_order_slack;
+
+			m_order_next = begin + 1;
+			m_order_begin.store(begin, etl::memory_order_relaxed);
+			m_order_end.store(begin + s_order_slack, etl::memory_order_relaxed);
+			return;
+		}
+
+		rebuild_hierarchy_order();
+	}
+
+	void Struct::update_hierarchy_order()
+	{
+		ScopeLock lock(hierarchy_order().cs);
+		rebuild_hierarchy_order();
+	}
+
+	void Struct::rebuild_hierarchy_order()
+	{
+		HierarchyOrder& order = hierarchy_order();
+
+		s_order_sequence.fetch_add(1, etl::memory_order_acq_rel);
+		std::atomic_thread_fence(etl::memory_order_release);
+
+		u32 next = 1;
+
+		for (Struct* root : order.roots)
+		{
+			root->assign_order(next);
+			next = root->m_order_end.load(etl::memory_order_relaxed);
+		}
+
+		order.next_root = next;
+		s_order_sequence.fetch_add(1, etl::memory_order_release);
 	}
 
 	Struct& Struct::construct()
@@ -60,6 +159,8 @@ namespace Trinex::Refl
 
 			if (it != m_properties.end())
 				m_properties.erase(it);
+
+			reset_serialization_plan();
 		}
 
 		return *this;
@@ -72,6 +173,7 @@ namespace Trinex::Refl
 		if (auto prop = instance_cast<Property>(subobject))
 		{
 			m_properties.push_back(prop);
+			reset_serialization_plan();
 		}
 
 		return *this;
@@ -172,7 +274,7 @@ namespace Trinex::Refl
 		return flags.all(IsScriptable);
 	}
 
-	bool Struct::is_a(const Struct* other) const
+	bool Struct::is_a_slow(const Struct* other) const
 	{
 		const Struct* current = this;
 		while (current && current != other)
@@ -219,9 +321,189 @@ namespace Trinex::Refl
 		return result;
 	}
 
-	bool Struct::serialize_properties(void* object, Archive& ar)
+	// Steps of the plan follow the declaration order of the properties. Trivially copyable properties which are adjacent
+	// in memory are coalesced into a single memory run, other properties are serialized with the size prefix
+	struct Struct::SerializationPlan {
+		struct Step {
+			Property* property;// nullptr for the memory runs
+			usize offset;
+			usize size;
+		};
+
+		Vector<Step> steps;
+		Archive::SchemaTable::Schema schema;
+	};
+
+	static bool is_trivially_serializable(Property* prop)
+	{
+		return Refl::Object::instance_cast<PrimitiveProperty>(prop) && prop->offset() >= 0;
+	}
+
+	const Struct::SerializationPlan& Struct::serialization_plan()
+	{
+		SerializationPlan* plan = m_serialization_plan.load(etl::memory_order_acquire);
+
+		if (plan)
+			return *plan;
+
+		SerializationPlan* new_plan = trx_new SerializationPlan();
+		new_plan->schema.name       = full_name();
+
+		String layout;
+
+		for (Property* prop : m_properties)
+		{
+			if (prop->is_transient())
+				continue;
+
+			const bool is_trivial = is_trivially_serializable(prop);
+			const usize size      = prop->size();
+
+			new_plan->schema.fields.push_back({prop->name().to_string(), is_trivial ? static_cast<u32>(size) : 0U});
+			layout += Strings::format("{}:{};", prop->name().to_string(), new_plan->schema.fields.back().size);
+
+			if (!is_trivial)
+			{
+				new_plan->steps.push_back({prop, 0, 0});
+				continue;
+			}
+
+			const usize offset = static_cast<usize>(prop->offset());
+
+			if (!new_plan->steps.empty())
+			{
+				SerializationPlan::Step& last = new_plan->steps.back();
+
+				if (last.property == nullptr && last.offset + last.size == offset)
+				{
+					last.size += size;
+					continue;
+				}
+			}
+
+			new_plan->steps.push_back({nullptr, offset, size});
+		}
+
+		new_plan->schema.hash = Strings::hash_of(layout);
+
+		if (m_serialization_plan.compare_exchange_strong(plan, new_plan, etl::memory_order_acq_rel))
+			return *new_plan;
+
+		trx_delete new_plan;
+		return *plan;
+	}
+
+	void Struct::reset_serialization_plan()
 	{
+		if (SerializationPlan* plan = m_serialization_plan.exchange(nullptr, etl::memory_order_acq_rel))
+		{
+			trx_delete plan;
+		}
+	}
+
+	static void serialize_sized(Property* prop, void* object, Archive& ar)
+	{
+		const usize start = ar.position();
+		usize size        = 0;
+		ar.serialize(size);
+
 		if (ar.is_saving())
+		{
+			prop->serialize(object, ar);
+
+			const usize end = ar.position();
+			size            = end - start - sizeof(size);
+			ar.position(start).serialize(size);
+			ar.position(end);
+		}
+		else
+		{
+			if (prop)
+				prop->serialize(object, ar);
+
+			ar.position(start + sizeof(size) + size);
+		}
+	}
+
+	bool Struct::serialize_compiled(void* object, Archive& ar)
+	{
+		const SerializationPlan& plan = serialization_plan();
+		u8* base                      = static_cast<u8*>(object);
+
+		u32 index = 0;
+
+		if (ar.is_saving())
+			index = ar.schemas->add(this, plan.schema);
+
+		ar.serialize(index);
+
+		if (ar.is_saving())
+		{
+			for (const SerializationPlan::Step& step : plan.steps)
+			{
+				if (step.property)
+					serialize_sized(step.property, object, ar);
+				else
+					ar.write_data(base + step.offset, step.size);
+			}
+
+			return ar;
+		}
+
+		if (index >= ar.schemas->schemas.size())
+		{
+			trinex_error(Log::Core, "Invalid schema index %u of struct '%s'", index, full_name().c_str());
+			return false;
+		}
+
+		const Archive::SchemaTable::Schema& schema = ar.schemas->schemas[index];
+
+		if (schema.hash == plan.schema.hash)
+		{
+			for (const SerializationPlan::Step& step : plan.steps)
+			{
+				if (step.property)
+					serialize_sized(step.property, object, ar);
+				else
+					ar.read_data(base + step.offset, step.size);
+			}
+
+			return ar;
+		}
+
+		// Layout of the struct was changed since the data was saved, so fields are matched by name
+		for (const Archive::SchemaTable::Field& field : schema.fields)
+		{
+			Property* prop = find<Property>(field.name);
+
+			if (prop && prop->is_transient())
+				prop = nullptr;
+
+			if (field.size == 0)
+			{
+				serialize_sized(prop, object, ar);
+			}
+			else if (prop && is_trivially_serializable(prop) && prop->size() == field.size)
+			{
+				prop->serialize(object, ar);
+			}
+			else
+			{
+				ar.position(ar.position() + field.size);
+			}
+		}
+
+		return ar;
+	}
+
+	bool Struct::serialize_properties(void* object, Archive& ar)
+	{
+		if (ar.schemas)
+		{
+			if (!serialize_compiled(object, ar))
+				return false;
+		}
+		else if (ar.is_saving())
 		{
 			auto properties = collect_serializable_properties(this);
 
@@ -354,6 +636,7 @@ namespace Trinex::Refl
 	Struct::~Struct()
 	{
 		m_properties.clear();
+		reset_serialization_plan();
 
 		destroy_derived_structs();
 
@@ -361,6 +644,12 @@ namespace Trinex::Refl
 		{
 			m_parent->m_derived_structs.erase(this);
 		}
+		else
+		{
+			HierarchyOrder& order = hierarchy_order();
+			ScopeLock lock(order.cs);
+			order.roots.erase(std::remove(order.roots.begin(), order.roots.end(), this), order.roots.end());
+		}
 	}
 
 	static bool is_a_scriptable(const Struct* self, const Struct* other)
@@ -1,11 +1,17 @@
 #include <Core/etl/atomic.hpp>
+#include <Core/etl/concurrent_queue.hpp>
 #include <Core/etl/critical_section.hpp>
 #include <Core/etl/deque.hpp>
 #include <Core/etl/scope_variable.hpp>
 #include <Core/etl/vector.hpp>
+#include <Core/etl/work_stealing_deque.hpp>
 #include <Core/math/math.hpp>
 #include <Core/memory.hpp>
+#include <Core/memory_tracker.hpp>
+#include <Core/profiler.hpp>
+#include <Core/string_functions.hpp>
 #include <Core/threading.hpp>
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
 #include <thread>
@@ -26,65 +32,172 @@ namespace Trinex
 
 	///////////////// TASK CLASS IMPLEMENTATION /////////////////
 
-	class Task::TaskImpl
+	static Atomic<usize> s_task_allocations = 0;
+
+	// Lock-free object cache. Every thread keeps a private free list, surplus objects are moved to the global list in batches.
+	// Global list is only pushed to or taken entirely, so it is not affected by the ABA problem.
+	template<typename Type>
+	class TaskObjectCache
 	{
-	public:
-		static Atomic<TaskImpl*> s_task_queue;
+	private:
+		static constexpr usize s_batch_size = 64;
+
+		struct Local {
+			Type* head  = nullptr;
+			usize count = 0;
+
+			~Local()
+			{
+				if (head)
+					push_global(head);
+			}
+		};
+
+		static inline Atomic<Type*> s_global = nullptr;
+		static inline thread_local Local s_local;
+
+		static void push_global(Type* first)
+		{
+			Type* last = first;
+			while (last->m_pool_next) last = last->m_pool_next;
+
+			Type* head = s_global.load(etl::memory_order_relaxed);
+
+			do
+			{
+				last->m_pool_next = head;
+			} while (!s_global.compare_exchange_weak(head, first, etl::memory_order_release, etl::memory_order_relaxed));
+		}
 
 	public:
-		CriticalSection m_cs;
+		static Type* allocate()
+		{
+			Local& local = s_local;
+
+			if (local.head == nullptr)
+			{
+				local.head  = s_global.exchange(nullptr, etl::memory_order_acquire);
+				local.count = 0;
+			}
+
+			if (Type* object = local.head)
+			{
+				local.head          = object->m_pool_next;
+				object->m_pool_next = nullptr;
+				local.count         = local.count > 0 ? local.count - 1 : 0;
+				return object;
+			}
+
+			s_task_allocations.fetch_add(1, etl::memory_order_relaxed);
+
+			trinex_memory_tag(Task);
+			return trx_new Type();
+		}
+
+		static void deallocate(Type* object)
+		{
+			Local& local        = s_local;
+			object->m_pool_next = local.head;
+			local.head          = object;
+
+			if (++local.count >= s_batch_size * 2)
+			{
+				Type* batch = local.head;
+				Type* last  = batch;
 
-		Atomic<TaskImpl*> m_next = nullptr;
+				for (usize i = 1; i < s_batch_size; ++i) last = last->m_pool_next;
 
-		union
+				local.head        = last->m_pool_next;
+				last->m_pool_next = nullptr;
+				local.count -= s_batch_size;
+				push_global(batch);
+			}
+		}
+
+		static void destroy_all()
 		{
-			u8* m_data = nullptr;
-			Task::Function* m_function;
+			Type* head = s_global.exchange(nullptr, etl::memory_order_acquire);
+
+			while (head)
+			{
+				Type* next = head->m_pool_next;
+				trx_delete head;
+				head = next;
+			}
+		}
+	};
+
+	class Task::TaskImpl
+	{
+	public:
+		struct DependentNode {
+			DependentNode* m_pool_next = nullptr;
+			DependentNode* m_next      = nullptr;
+			TaskImpl* m_task           = nullptr;
 		};
 
-		usize m_data_size = 0;
+		using Pool     = TaskObjectCache<TaskImpl>;
+		using NodePool = TaskObjectCache<DependentNode>;
+
+		// Functors up to this size and alignment are stored inside of the task
+		static constexpr usize s_inline_size  = 64;
+		static constexpr usize s_inline_align = 16;
 
-		TaskQueue* m_queue = nullptr;
-		Vector<Task> m_dependents;
+		// Execution state: number of active workers and the closed flag, set when any worker finishes the task
+		static constexpr u32 s_workers_mask = 0xFFFF;
+		static constexpr u32 s_closed_flag  = 0x10000;
 
-		Atomic<u32> m_dependencies = 0;
-		Atomic<u32> m_refs         = 1;
-		Atomic<Status> m_status    = Undefined;
+		static inline DependentNode* closed_list() { return reinterpret_cast<DependentNode*>(usize(1)); }
+
+	public:
+		TaskImpl* m_pool_next = nullptr;
+
+		alignas(s_inline_align) u8 m_inline_data[s_inline_size];
+		Task::Function* m_function = nullptr;
+		u8* m_heap_data            = nullptr;
+		usize m_heap_size          = 0;
+
+		Atomic<TaskQueue*> m_queue          = nullptr;
+		Atomic<DependentNode*> m_dependents = nullptr;
+		Atomic<u32> m_dependencies          = 0;
+		Atomic<u32> m_refs                  = 1;
+		Atomic<u32> m_execution             = 0;
+		Atomic<Status> m_status             = Undefined;
 
 		Priority m_priority = Middle;
-		u16 m_workers       = 0;
 		u16 m_max_threads   = 1;
 
 	public:
-		static TaskImpl* allocate()
-		{
-			TaskImpl* head = s_task_queue.load(etl::memory_order_acquire);
+		static inline TaskImpl* allocate() { return Pool::allocate(); }
 
-			while (head)
+		static void release_dependents(DependentNode* node, bool notify)
+		{
+			while (node && node != closed_list())
 			{
-				TaskImpl* next = head->m_next.load(etl::memory_order_relaxed);
+				DependentNode* next = node->m_next;
 
-				if (s_task_queue.compare_exchange_weak(head, next, etl::memory_order_acquire, etl::memory_order_relaxed))
-				{
-					head->m_next.store(nullptr, etl::memory_order_relaxed);
-					return head;
-				}
-			}
+				if (notify)
+					node->m_task->remove_dependency();
 
-			return trx_new TaskImpl();
+				node->m_task->release();
+				NodePool::deallocate(node);
+				node = next;
+			}
 		}
 
 		inline void reset()
 		{
-			m_queue = nullptr;
-			m_dependents.clear();
+			release_dependents(m_dependents.exchange(nullptr, etl::memory_order_acquire), false);
+
+			m_queue.store(nullptr, etl::memory_order_relaxed);
 			m_refs.store(1, etl::memory_order_relaxed);
+			m_execution.store(0, etl::memory_order_relaxed);
 			m_status      = Undefined;
 			m_priority    = Middle;
-			m_workers     = 0;
 			m_max_threads = 1;
 
 			m_function->~Function();
+			m_function = nullptr;
 		}
 
 		inline void add_ref(u32 count = 1) { m_refs.fetch_add(count, etl::memory_order_relaxed); }
@@ -94,14 +207,7 @@ namespace Trinex
 			if (m_refs.fetch_sub(1, etl::memory_order_acq_rel) == 1)
 			{
 				reset();
-
-				TaskImpl* head = s_task_queue.load(etl::memory_order_relaxed);
-
-				do
-				{
-					m_next.store(head, etl::memory_order_relaxed);
-				} while (!s_task_queue.compare_exchange_weak(head, this, etl::memory_order_release, etl::memory_order_relaxed));
-
+				Pool::deallocate(this);
 				return false;
 			}
 
@@ -112,9 +218,9 @@ namespace Trinex
 		{
 			if (--m_dependencies == 0)
 			{
-				if (m_queue)
+				if (TaskQueue* queue = m_queue.load())
 				{
-					m_queue->add_task_internal(this);
+					queue->add_task_internal(this);
 				}
 			}
 		}
@@ -126,55 +232,82 @@ namespace Trinex
 				m_function->execute();
 			}
 
-			if (m_max_threads > 1)
+			// Finished worker closes the task for new workers, the last one completes it
+			u32 state = m_execution.load(etl::memory_order_relaxed);
+
+			while (!m_execution.compare_exchange_weak(state, (state - 1) | s_closed_flag, etl::memory_order_acq_rel,
+			                                          etl::memory_order_relaxed))
 			{
-				ScopeLock lock(m_cs);
+			}
 
-				if (--m_workers == 0)
-				{
-					m_status.store(Status::Executed, etl::memory_order_release);
+			if ((state & s_workers_mask) != 1)
+			{
+				Status status = Status::Executing;
+				m_status.compare_exchange_strong(status, Status::Completing, etl::memory_order_acq_rel);
+				return false;
+			}
 
-					for (Task& dependent : m_dependents)
-					{
-						dependent.m_impl->remove_dependency();
-					}
+			DependentNode* dependents = m_dependents.exchange(closed_list(), etl::memory_order_acq_rel);
+			m_status.store(Status::Executed, etl::memory_order_release);
+			release_dependents(dependents, true);
+			return true;
+		}
 
-					return true;
-				}
-				else
+		// Returns false if this task is already completed
+		inline bool add_dependent(TaskImpl* dependent)
+		{
+			DependentNode* node = NodePool::allocate();
+			node->m_task        = dependent;
+
+			dependent->add_ref();
+			dependent->m_dependencies += 1;
+
+			DependentNode* head = m_dependents.load(etl::memory_order_relaxed);
+
+			do
+			{
+				if (head == closed_list())
 				{
-					m_status.store(Status::Completing, etl::memory_order_release);
+					node->m_task = nullptr;
+					NodePool::deallocate(node);
+
+					dependent->remove_dependency();
+					dependent->release();
 					return false;
 				}
-			}
-			else
-			{
-				trinex_assert(--m_workers == 0);
-				m_status.store(Status::Executed, etl::memory_order_release);
 
-				for (Task& dependent : m_dependents)
-				{
-					dependent.m_impl->remove_dependency();
-				}
-				return true;
-			}
+				node->m_next = head;
+			} while (!m_dependents.compare_exchange_weak(head, node, etl::memory_order_release, etl::memory_order_relaxed));
+
+			return true;
 		}
 
-		inline void* data(usize size)
+		inline void* data(usize size, usize align)
 		{
-			if (m_data_size < size)
+			if (size <= s_inline_size && align <= s_inline_align)
+			{
+				m_function = reinterpret_cast<Task::Function*>(m_inline_data);
+				return m_inline_data;
+			}
+
+			// Buffer of the previous functor is reused only if it is large enough and aligned for this one
+			if (m_heap_size < size || reinterpret_cast<usize>(m_heap_data) % align != 0)
 			{
 				size = align_up(size, 64);
+				trinex_memory_tag(Task);
 
-				ByteAllocator::deallocate(m_data);
-				m_data      = ByteAllocator::allocate(size);
-				m_data_size = size;
+				ByteAllocator::deallocate(m_heap_data);
+				m_heap_data = ByteAllocator::allocate_aligned(size, Math::max<usize>(align, 16));
+				m_heap_size = size;
+				s_task_allocations.fetch_add(1, etl::memory_order_relaxed);
 			}
-			return m_data;
+
+			m_function = reinterpret_cast<Task::Function*>(m_heap_data);
+			return m_heap_data;
 		}
-	};
 
-	Atomic<Task::TaskImpl*> Task::TaskImpl::s_task_queue;
+		~TaskImpl() { ByteAllocator::deallocate(m_heap_data); }
+	};
 
 	Task::Task() {}
 
@@ -183,9 +316,9 @@ namespace Trinex
 		m_impl->m_priority = priority;
 	}
 
-	void* Task::data(usize size)
+	void* Task::data(usize size, usize align)
 	{
-		return m_impl->data(size);
+		return m_impl->data(size, align);
 	}
 
 	Task::Task(const Task& task) : m_impl(task.m_impl)
@@ -203,9 +336,13 @@ namespace Trinex
 		if (this == &task)
 			return *this;
 
-		m_impl->release();
+		if (m_impl)
+			m_impl->release();
+
 		m_impl = task.m_impl;
-		m_impl->add_ref();
+
+		if (m_impl)
+			m_impl->add_ref();
 		return *this;
 	}
 
@@ -214,7 +351,9 @@ namespace Trinex
 		if (this == &task)
 			return *this;
 
-		m_impl->release();
+		if (m_impl)
+			m_impl->release();
+
 		m_impl      = task.m_impl;
 		task.m_impl = nullptr;
 		return *this;
@@ -231,23 +370,27 @@ namespace Trinex
 		return s_worker_idx;
 	}
 
+	usize Task::heap_allocations()
+	{
+		return s_task_allocations.load(etl::memory_order_relaxed);
+	}
+
 	Task& Task::max_threads(u32 count)
 	{
-		m_impl->m_max_threads = Math::clamp<u32>(count, 1U, 0xFFFFU);
+		m_impl->m_max_threads = Math::clamp<u32>(count, 1U, TaskImpl::s_workers_mask);
 		return *this;
 	}
 
 	Task& Task::add_dependent(const Task& dependent)
 	{
-		m_impl->m_dependents.push_back(dependent);
-		dependent.m_impl->m_dependencies += 1;
+		m_impl->add_dependent(dependent.m_impl);
 		return *this;
 	}
 
 	Task& Task::add_dependent(Task&& dependent)
 	{
-		dependent.m_impl->m_dependencies += 1;
-		m_impl->m_dependents.push_back(etl::move(dependent));
+		m_impl->add_dependent(dependent.m_impl);
+		dependent = Task();
 		return *this;
 	}
 
@@ -387,7 +530,7 @@ namespace Trinex
 			{
 				Task::TaskImpl* t = etl::move(queue.front());
 				t->m_status       = Task::Executing;
-				t->m_workers      = 1;
+				t->m_execution.store(1, etl::memory_order_relaxed);
 				queue.pop_front();
 				return t;
 			}
@@ -455,6 +598,7 @@ namespace Trinex
 			ScopeLock lock(m_thread->m_cs);
 			task.m_impl->add_ref();
 			task.m_impl->m_max_threads = 1;
+			task.m_impl->m_status.store(Task::Pending, etl::memory_order_release);
 			m_thread->m_tasks[task.priority()].emplace_back(task.m_impl);
 		}
 
@@ -469,6 +613,7 @@ namespace Trinex
 	{
 		{
 			ScopeLock lock(m_thread->m_cs);
+			task.m_impl->m_status.store(Task::Pending, etl::memory_order_release);
 			m_thread->m_tasks[task.priority()].emplace_back(task.m_impl);
 		}
 
@@ -510,125 +655,345 @@ namespace Trinex
 	class TaskGraphImpl : public TaskQueue
 	{
 	private:
-		Vector<Thread*> m_workers;
-		Deque<Task::TaskImpl*> m_tasks[3];
+		static constexpr u32 s_priorities      = Task::Low + 1;
+		static constexpr u32 s_aging_threshold = 32;
+
+		struct alignas(64) Counters {
+			Atomic<u64> executed    = 0;
+			Atomic<u64> stolen      = 0;
+			Atomic<u64> busy_time   = 0;
+			Atomic<u64> idle_time   = 0;
+			Atomic<u64> wait_time   = 0;
+			Atomic<u64> queue_depth = 0;
+
+			inline void add(Atomic<u64>& counter, u64 value) { counter.fetch_add(value, etl::memory_order_relaxed); }
+
+			inline void update_max(Atomic<u64>& counter, u64 value)
+			{
+				u64 current = counter.load(etl::memory_order_relaxed);
+				while (current < value && !counter.compare_exchange_weak(current, value, etl::memory_order_relaxed)) {}
+			}
+
+			TaskGraph::WorkerStats snapshot() const
+			{
+				TaskGraph::WorkerStats stats;
+				stats.executed    = executed.load(etl::memory_order_relaxed);
+				stats.stolen      = stolen.load(etl::memory_order_relaxed);
+				stats.busy_time   = busy_time.load(etl::memory_order_relaxed);
+				stats.idle_time   = idle_time.load(etl::memory_order_relaxed);
+				stats.wait_time   = wait_time.load(etl::memory_order_relaxed);
+				stats.queue_depth = queue_depth.load(etl::memory_order_relaxed);
+				return stats;
+			}
+
+			void reset()
+			{
+				executed.store(0, etl::memory_order_relaxed);
+				stolen.store(0, etl::memory_order_relaxed);
+				busy_time.store(0, etl::memory_order_relaxed);
+				idle_time.store(0, etl::memory_order_relaxed);
+				wait_time.store(0, etl::memory_order_relaxed);
+				queue_depth.store(0, etl::memory_order_relaxed);
+			}
+		};
+
+		struct Worker {
+			WorkStealingDeque<Task::TaskImpl*> m_queues[s_priorities];
+			Counters m_stats;
+			TaskGraphImpl* m_graph = nullptr;
+			Thread* m_thread       = nullptr;
+			u32 m_index            = 0;
+			u32 m_seed             = 0;
+			u32 m_skipped[s_priorities]{};
+
+#ifdef TRACY_ENABLE
+			String m_plot_name;
+			u64 m_plot_busy_time = 0;
+#endif
+		};
 
-		std::mutex m_mutex;
-		std::condition_variable m_cv;
-		bool m_stop{false};
+		static thread_local Worker* s_worker;
+
+		Vector<Worker*> m_workers;
+		ConcurrentQueue<Task::TaskImpl*> m_injection[s_priorities];
+
+		// Statistics of external threads, which submit tasks or help in wait_for
+		Counters m_external_stats;
+
+#ifdef TRACY_ENABLE
+		u64 m_frame_start    = 0;
+		u64 m_plot_executed  = 0;
+		u64 m_plot_stolen    = 0;
+		u64 m_plot_wait_time = 0;
+#endif
+
+		alignas(64) Atomic<u32> m_epoch = 0;
+		alignas(64) Atomic<u32> m_sleepers = 0;
+		Atomic<u64> m_deadline             = 0;
+		Atomic<bool> m_stop                = false;
 
 	private:
-		inline bool is_empty()
+		static inline u64 now()
+		{
+			using namespace std::chrono;
+			return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+		}
+
+		inline Counters& stats() { return s_worker ? s_worker->m_stats : m_external_stats; }
+
+		static inline u32 next_random(u32& seed)
+		{
+			seed ^= seed << 13;
+			seed ^= seed >> 17;
+			seed ^= seed << 5;
+			return seed;
+		}
+
+		static bool claim_task(Task::TaskImpl* task, u16& worker)
 		{
-			for (u32 i = Task::High; i <= Task::Low; ++i)
+			if (task->m_max_threads > 1)
 			{
-				if (!m_tasks[i].empty())
-					return false;
+				u32 state = task->m_execution.load(etl::memory_order_relaxed);
+
+				do
+				{
+					if ((state & Task::TaskImpl::s_closed_flag) || (state & Task::TaskImpl::s_workers_mask) >= task->m_max_threads)
+						return false;
+				} while (!task->m_execution.compare_exchange_weak(state, state + 1, etl::memory_order_acq_rel,
+				                                                  etl::memory_order_relaxed));
+
+				worker = static_cast<u16>(state & Task::TaskImpl::s_workers_mask);
+
+				Task::Status status = Task::Status::Pending;
+				task->m_status.compare_exchange_strong(status, Task::Status::Executing, etl::memory_order_acq_rel);
+				return true;
 			}
-			return true;
+
+			Task::Status status = Task::Status::Pending;
+
+			if (task->m_status.compare_exchange_strong(status, Task::Status::Executing))
+			{
+				task->m_execution.store(1, etl::memory_order_relaxed);
+				worker = 0;
+				return true;
+			}
+
+			return false;
 		}
 
-		Task::TaskImpl* acquire_task_locked(Deque<Task::TaskImpl*>& queue, u16& worker)
+		inline void run_task(Task::TaskImpl* task)
 		{
-			while (!queue.empty())
+			u16 worker;
+
+			if (claim_task(task, worker))
 			{
-				Task::TaskImpl* task  = queue.front();
-				const u32 max_threads = task->m_max_threads;
+				const u64 start = now();
+				task->execute(worker);
+
+				Counters& counters = stats();
+				counters.add(counters.executed, 1);
+				counters.add(counters.busy_time, now() - start);
+			}
+
+			// Every queue entry holds one reference to the task
+			task->release();
+		}
+
+		bool steal_task(u32 priority, u32 start, Task::TaskImpl*& task)
+		{
+			const u32 count = m_workers.size();
 
-				if (max_threads > 1)
+			for (u32 i = 0; i < count; ++i)
+			{
+				Worker* victim = m_workers[(start + i) % count];
+
+				if (victim != s_worker && victim->m_queues[priority].steal(task))
 				{
-					ScopeLock lock(task->m_cs);
+					Counters& counters = stats();
+					counters.add(counters.stolen, 1);
+					return true;
+				}
+			}
 
-					if (task->m_workers < max_threads)
-					{
-						Task::Status status = task->m_status.load(etl::memory_order_acquire);
+			return false;
+		}
 
-						if (status == Task::Status::Executed || status == Task::Status::Completing)
-						{
-							queue.pop_front();
-							task->release();
-							continue;
-						}
+		inline bool is_deferred(u32 priority) const
+		{
+			if (priority != Task::Low)
+				return false;
 
-						worker = task->m_workers++;
+			const u64 deadline = m_deadline.load(etl::memory_order_relaxed);
+			return deadline != 0 && now() >= deadline;
+		}
 
-						if (status == Task::Status::Pending)
-							task->m_status = Task::Status::Executing;
+		bool find_task(u32 priority, Worker* self, u32 start, Task::TaskImpl*& task)
+		{
+			if (self && self->m_queues[priority].pop(task))
+				return true;
 
-						return task;
-					}
+			if (m_injection[priority].pop(task))
+				return true;
 
-					queue.pop_front();
-					task->release();
-				}
-				else
-				{
-					queue.pop_front();
-					task->release();
+			return steal_task(priority, start, task);
+		}
 
-					Task::Status status = Task::Status::Pending;
+		Task::TaskImpl* find_task(bool respect_deadline = true)
+		{
+			Task::TaskImpl* task = nullptr;
+			Worker* self         = s_worker;
+			u32 start            = self ? next_random(self->m_seed) : 0;
+			u32 first            = Task::High;
 
-					if (task->m_status.compare_exchange_weak(status, Task::Status::Executing))
+			if (self)
+			{
+				// Anti-starvation aging: a priority that was skipped too many times is served first
+				for (u32 priority = Task::Low; priority > Task::High; --priority)
+				{
+					if (self->m_skipped[priority] >= s_aging_threshold)
 					{
-						task->m_status.store(Task::Status::Executing, etl::memory_order_release);
-						task->m_workers = 1;
-						worker          = 0;
-						return task;
+						first = priority;
+						break;
 					}
 				}
 			}
-			return nullptr;
-		}
 
-		Task::TaskImpl* acquire_task_locked(u16& worker)
-		{
-			for (u32 i = Task::High; i <= Task::Low; ++i)
+			for (u32 index = 0; index < s_priorities; ++index)
 			{
-				if (Task::TaskImpl* task = acquire_task_locked(m_tasks[i], worker))
+				const u32 priority = index == 0 ? first : (index <= first ? index - 1 : index);
+
+				if (respect_deadline && is_deferred(priority))
+					continue;
+
+				if (find_task(priority, self, start, task))
+				{
+					if (self)
+					{
+						self->m_skipped[priority] = 0;
+
+						for (u32 lower = priority + 1; lower < s_priorities; ++lower) ++self->m_skipped[lower];
+					}
+
 					return task;
+				}
+
+				// Nothing is waiting on this priority, so it cannot starve
+				if (self)
+					self->m_skipped[priority] = 0;
 			}
 
 			return nullptr;
 		}
 
-		inline Task::TaskImpl* acquire_task(u16& worker)
+		inline bool execute_once(bool respect_deadline = true)
 		{
-			if (m_mutex.try_lock())
+			if (Task::TaskImpl* task = find_task(respect_deadline))
 			{
-				Task::TaskImpl* task = acquire_task_locked(worker);
-				m_mutex.unlock();
-				return task;
+				run_task(task);
+				return true;
 			}
+			return false;
+		}
 
-			return nullptr;
+		void notify(u32 count)
+		{
+			m_epoch.fetch_add(1, etl::memory_order_seq_cst);
+
+			if (m_sleepers.load(etl::memory_order_seq_cst) > 0)
+			{
+				if (count > 1)
+					m_epoch.notify_all();
+				else
+					m_epoch.notify_one();
+			}
 		}
 
-		static void worker_main(void* self) { static_cast<TaskGraphImpl*>(self)->worker_loop(); }
+		static void worker_main(void* data)
+		{
+			Worker* worker = static_cast<Worker*>(data);
+			s_worker       = worker;
+			worker->m_graph->worker_loop();
+			s_worker = nullptr;
+		}
 
 		void worker_loop()
 		{
-			while (true)
+			while (!m_stop.load(etl::memory_order_acquire))
 			{
-				u16 worker;
-				Task::TaskImpl* task = nullptr;
-				{
-					std::unique_lock<std::mutex> lock(m_mutex);
-					m_cv.wait(lock, [this] { return m_stop || !is_empty(); });
+				if (execute_once())
+					continue;
+
+				const u32 epoch = m_epoch.load(etl::memory_order_seq_cst);
+				m_sleepers.fetch_add(1, etl::memory_order_seq_cst);
 
-					if (m_stop)
-						return;
+				if (!m_stop.load(etl::memory_order_acquire))
+				{
+					if (Task::TaskImpl* task = find_task())
+					{
+						m_sleepers.fetch_sub(1, etl::memory_order_seq_cst);
+						run_task(task);
+						continue;
+					}
 
-					task = acquire_task_locked(worker);
+					const u64 start = now();
+					m_epoch.wait(epoch, etl::memory_order_seq_cst);
+					s_worker->m_stats.add(s_worker->m_stats.idle_time, now() - start);
 				}
 
-				if (task == nullptr)
-					continue;
+				m_sleepers.fetch_sub(1, etl::memory_order_seq_cst);
+			}
+		}
 
-				if (task && task->execute(worker))
+		void push_task(Task::TaskImpl* task, u32 priority)
+		{
+			if (Worker* self = s_worker)
+			{
+				self->m_queues[priority].push(task);
+				self->m_stats.update_max(self->m_stats.queue_depth, self->m_queues[priority].size());
+				return;
+			}
+
+			if (!m_injection[priority].push(task))
+			{
+				const u64 start = now();
+
+				while (!m_injection[priority].push(task))
 				{
-					task->release();
+					// Injection queue is full, help the workers to drain it
+					if (!execute_once())
+						Thread::static_yield();
 				}
+
+				m_external_stats.add(m_external_stats.wait_time, now() - start);
+			}
+
+			m_external_stats.update_max(m_external_stats.queue_depth, m_injection[priority].size());
+		}
+
+		void schedule(Task::TaskImpl* task)
+		{
+			Task::Status status = Task::Status::Undefined;
+
+			if (!task->m_status.compare_exchange_strong(status, Task::Status::Pending))
+				return;
+
+			const u32 priority = task->m_priority;
+			u32 entries        = 1;
+
+			if (task->m_max_threads > 1)
+			{
+				// Calling thread may also participate in the execution of the task
+				entries = Math::min<u32>(task->m_max_threads, m_workers.size() + 1);
+			}
+
+			task->add_ref(entries);
+
+			for (u32 i = 0; i < entries; ++i)
+			{
+				push_task(task, priority);
 			}
+
+			notify(entries);
 		}
 
 	public:
@@ -638,116 +1003,149 @@ namespace Trinex
 				thread_count = 1;
 
 			m_workers.reserve(thread_count);
-			for (usize i = 0; i < thread_count; ++i) m_workers.emplace_back(trx_new Thread(worker_main, this));
+
+			for (usize i = 0; i < thread_count; ++i)
+			{
+				Worker* worker  = trx_new Worker();
+				worker->m_graph = this;
+				worker->m_index = i;
+				worker->m_seed  = 0x9E3779B9U * (i + 1);
+#ifdef TRACY_ENABLE
+				worker->m_plot_name = Strings::format("TaskGraph worker {} busy %", i);
+#endif
+				m_workers.push_back(worker);
+			}
+
+			for (Worker* worker : m_workers) worker->m_thread = trx_new Thread(worker_main, worker);
 		}
 
 		~TaskGraphImpl()
 		{
+			m_stop.store(true, etl::memory_order_release);
+			m_epoch.fetch_add(1, etl::memory_order_seq_cst);
+			m_epoch.notify_all();
+
+			for (Worker* worker : m_workers)
 			{
-				std::unique_lock lock(m_mutex);
-				m_stop = true;
+				trx_delete worker->m_thread;
+				trx_delete worker;
 			}
-			m_cv.notify_all();
-			for (Thread* worker : m_workers) trx_delete worker;
 		}
 
-		void add_task_locked(Task::TaskImpl* task)
-		{
-			task->m_queue = this;
-			task->m_status.store(Task::Status::Pending, etl::memory_order_release);
-
-			task->add_ref(2);
+		void add_task_internal(Task::TaskImpl* task) override { schedule(task); }
 
-			m_tasks[task->m_priority].push_back(task);
+		void add_task(Task::TaskImpl* task)
+		{
+			TaskQueue* queue = nullptr;
 
-			if (task->m_max_threads > 1)
-				m_cv.notify_all();
-			else
-				m_cv.notify_one();
-		}
+			if (!task->m_queue.compare_exchange_strong(queue, this))
+				return;
 
-		void add_task_internal(Task::TaskImpl* task) override
-		{
-			std::unique_lock lock(m_mutex);
-			add_task_locked(task);
+			if (task->m_dependencies.load() == 0)
+			{
+				schedule(task);
+			}
 		}
 
-		void add_task(Task::TaskImpl* task)
+		void wait_for(Task::TaskImpl* task)
 		{
-			if (task->m_queue != nullptr)
+			if (task->m_status.load(etl::memory_order_acquire) == Task::Status::Executed)
 				return;
 
-			std::unique_lock lock(m_mutex);
+			add_task(task);
 
-			if (task->m_dependencies == 0)
+			// Waiting thread ignores the frame deadline, otherwise waiting for a low priority task may never finish
+			while (task->m_status.load(etl::memory_order_acquire) != Task::Status::Executed)
 			{
-				add_task_locked(task);
+				if (!execute_once(false))
+					Thread::static_yield();
 			}
-			else
+		}
+
+		void begin_frame(f32 budget)
+		{
+			const u64 time = now();
+			u64 deadline   = budget > 0.f ? time + static_cast<u64>(budget * 1000000000.0) : 0;
+			m_deadline.store(deadline, etl::memory_order_relaxed);
+
+#ifdef TRACY_ENABLE
+			m_frame_start = time;
+#endif
+		}
+
+		void end_frame()
+		{
+			if (m_deadline.exchange(0, etl::memory_order_relaxed) != 0)
 			{
-				task->m_queue = this;
+				// Wake up workers that parked while low priority tasks were deferred
+				notify(m_workers.size());
 			}
+
+#ifdef TRACY_ENABLE
+			plot_frame_stats();
+#endif
 		}
 
-		void wait_for(Task::TaskImpl* task)
+#ifdef TRACY_ENABLE
+		void plot_frame_stats()
 		{
-			u16 worker;
-			Task::TaskImpl* current = nullptr;
-			{
-				std::unique_lock lock(m_mutex);
-				Task::Status status = task->m_status;
+			const u64 frame_time = m_frame_start ? now() - m_frame_start : 0;
+			u64 executed         = m_external_stats.executed.load(etl::memory_order_relaxed);
+			u64 stolen           = 0;
 
-				if (status == Task::Status::Executed)
-					return;
+			for (Worker* worker : m_workers)
+			{
+				const u64 busy_time = worker->m_stats.busy_time.load(etl::memory_order_relaxed);
 
-				if (task->m_queue == nullptr)
+				if (frame_time > 0)
 				{
-					if (task->m_dependencies == 0)
-					{
-						add_task_locked(task);
-					}
-					else
-					{
-						task->m_queue = this;
-					}
+					const f64 busy = static_cast<f64>(busy_time - worker->m_plot_busy_time) / static_cast<f64>(frame_time);
+					trinex_profile_plot(worker->m_plot_name.c_str(), Math::min(busy, 1.0) * 100.0);
 				}
 
-				current = acquire_task_locked(worker);
+				worker->m_plot_busy_time = busy_time;
+				executed += worker->m_stats.executed.load(etl::memory_order_relaxed);
+				stolen += worker->m_stats.stolen.load(etl::memory_order_relaxed);
 			}
 
-			if (current && current->execute(worker))
-			{
-				current->release();
-			}
+			const u64 wait_time = m_external_stats.wait_time.load(etl::memory_order_relaxed);
 
-			while (task->m_status.load(etl::memory_order_acquire) != Task::Status::Executed)
-			{
-				current = acquire_task(worker);
+			trinex_profile_plot("TaskGraph tasks", static_cast<i64>(executed - m_plot_executed));
+			trinex_profile_plot("TaskGraph steals", static_cast<i64>(stolen - m_plot_stolen));
+			trinex_profile_plot("TaskGraph injection wait (us)", static_cast<f64>(wait_time - m_plot_wait_time) / 1000.0);
 
-				if (current && current->execute(worker))
-				{
-					current->release();
-				}
-			}
+			m_plot_executed  = executed;
+			m_plot_stolen    = stolen;
+			m_plot_wait_time = wait_time;
+		}
+#endif
+
+		TaskGraph::WorkerStats worker_stats(u32 index) const
+		{
+			if (index < m_workers.size())
+				return m_workers[index]->m_stats.snapshot();
+			return m_external_stats.snapshot();
+		}
+
+		void reset_stats()
+		{
+			for (Worker* worker : m_workers) worker->m_stats.reset();
+			m_external_stats.reset();
 		}
 
 		u32 workers() const { return m_workers.size(); }
 	};
 
+	thread_local TaskGraphImpl::Worker* TaskGraphImpl::s_worker = nullptr;
+
 	TaskGraph::TaskGraph() : m_impl(trx_new TaskGraphImpl()) {}
 
 	TaskGraph::~TaskGraph()
 	{
 		trx_delete m_impl;
 
-		Task::TaskImpl* impl = Task::TaskImpl::s_task_queue;
-
-		while (impl)
-		{
-			Task::TaskImpl* next = impl->m_next;
-			trx_delete impl;
-			impl = next;
-		}
+		Task::TaskImpl::Pool::destroy_all();
+		Task::TaskImpl::NodePool::destroy_all();
 	}
 
 	TaskGraph* TaskGraph::instance()
@@ -773,6 +1171,39 @@ namespace Trinex
 		return *this;
 	}
 
+	bool TaskGraph::add_continuation(const Task& task, const Task& continuation)
+	{
+		if (!task.m_impl->add_dependent(continuation.m_impl))
+			return false;
+
+		m_impl->add_task(continuation.m_impl);
+		m_impl->add_task(task.m_impl);
+		return true;
+	}
+
+	TaskGraph::WorkerStats TaskGraph::worker_stats(u32 index) const
+	{
+		return m_impl->worker_stats(index);
+	}
+
+	TaskGraph& TaskGraph::reset_stats()
+	{
+		m_impl->reset_stats();
+		return *this;
+	}
+
+	TaskGraph& TaskGraph::begin_frame(f32 budget)
+	{
+		m_impl->begin_frame(budget);
+		return *this;
+	}
+
+	TaskGraph& TaskGraph::end_frame()
+	{
+		m_impl->end_frame();
+		return *this;
+	}
+
 	///////////////// NAMED THREADS IMPLEMENTATION /////////////////
 
 	static Thread* s_logic_thread = nullptr;
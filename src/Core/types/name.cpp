@@ -1,9 +1,11 @@
 #include <Core/archive.hpp>
 #include <Core/constants.hpp>
-#include <Core/etl/map.hpp>
+#include <Core/etl/allocator.hpp>
+#include <Core/etl/atomic.hpp>
+#include <Core/etl/critical_section.hpp>
 #include <Core/etl/templates.hpp>
-#include <Core/etl/vector.hpp>
 #include <Core/memory.hpp>
+#include <Core/parallel.hpp>
 #include <Core/types/name.hpp>
 #include <ScriptEngine/script_binding.hpp>
 
@@ -30,17 +32,178 @@ namespace Trinex
 	declare_name(direction);
 	declare_name(mask);
 
-	static Vector<Name::Entry>& name_entries()
+	// Names are interned into a global table, which is safe to use from any thread.
+	// Entries are stored in fixed size chunks and never move, so references returned by to_string stay valid.
+	// The index is split into shards by hash, lookups are lock-free and insertions lock only one shard.
+	class NameTable
 	{
-		static Vector<Name::Entry> entries;
-		return entries;
-	}
+	private:
+		static constexpr u32 s_chunk_bits   = 12;
+		static constexpr u32 s_chunk_size   = 1 << s_chunk_bits;
+		static constexpr u32 s_max_chunks   = 1 << 14;
+		static constexpr u32 s_shard_bits   = 6;
+		static constexpr u32 s_shard_count  = 1 << s_shard_bits;
+		static constexpr u32 s_min_capacity = 64;
+
+		// Open addressing table of the shard. Every slot stores the high half of the hash and the entry index + 1,
+		// zero means that the slot is empty. Slots are never removed, so readers need no synchronization besides acquire loads
+		struct Index {
+			Atomic<u64>* slots;
+			u32 mask;
+
+			static Index* create(u32 capacity)
+			{
+				u8* memory   = ByteAllocator::allocate_aligned(sizeof(Index) + sizeof(Atomic<u64>) * capacity, alignof(Index));
+				Index* index = new (memory) Index();
+				index->slots = reinterpret_cast<Atomic<u64>*>(memory + sizeof(Index));
+				index->mask  = capacity - 1;
 
-	static MultiMap<u64, usize>& name_index_map()
-	{
-		static MultiMap<u64, usize> indices;
-		return indices;
-	}
+				for (u32 i = 0; i < capacity; ++i) new (index->slots + i) Atomic<u64>(0);
+				return index;
+			}
+		};
+
+		struct alignas(Parallel::cache_line_size) Shard {
+			CriticalSection cs;
+			Atomic<Index*> index = nullptr;
+			u32 size             = 0;
+		};
+
+		Atomic<Name::Entry*> m_chunks[s_max_chunks] = {};
+		Atomic<u32> m_count                         = 0;
+		Shard m_shards[s_shard_count];
+
+		static FORCE_INLINE u64 pack(u64 hash, u32 entry) { return (hash & ~u64(0xFFFFFFFF)) | (static_cast<u64>(entry) + 1); }
+		static FORCE_INLINE u32 unpack(u64 slot) { return static_cast<u32>(slot) - 1; }
+		static FORCE_INLINE bool same_hash(u64 slot, u64 hash) { return ((slot ^ hash) >> 32) == 0; }
+		FORCE_INLINE Shard& shard(u64 hash) { return m_shards[hash >> (64 - s_shard_bits)]; }
+
+		Name::Entry* chunk(u32 chunk_index)
+		{
+			Name::Entry* chunk = m_chunks[chunk_index].load(etl::memory_order_acquire);
+
+			if (chunk)
+				return chunk;
+
+			auto memory = ByteAllocator::allocate_aligned(sizeof(Name::Entry) * s_chunk_size, alignof(Name::Entry));
+			chunk       = reinterpret_cast<Name::Entry*>(memory);
+
+			Name::Entry* expected = nullptr;
+
+			if (!m_chunks[chunk_index].compare_exchange_strong(expected, chunk, etl::memory_order_acq_rel))
+			{
+				ByteAllocator::deallocate(memory);
+				return expected;
+			}
+
+			return chunk;
+		}
+
+		u32 find(Index* index, const StringView& name, u64 hash) const
+		{
+			for (u32 slot = static_cast<u32>(hash) & index->mask;; slot = (slot + 1) & index->mask)
+			{
+				const u64 value = index->slots[slot].load(etl::memory_order_acquire);
+
+				if (value == 0)
+					return Name::invalid_index;
+
+				if (same_hash(value, hash))
+				{
+					const u32 entry_index = unpack(value);
+
+					if (entry(entry_index).name == name)
+						return entry_index;
+				}
+			}
+		}
+
+		static void insert(Index* index, u64 hash, u32 entry)
+		{
+			u32 slot = static_cast<u32>(hash) & index->mask;
+
+			while (index->slots[slot].load(etl::memory_order_relaxed) != 0) slot = (slot + 1) & index->mask;
+			index->slots[slot].store(pack(hash, entry), etl::memory_order_release);
+		}
+
+		// Called under the shard lock. The previous index can still be used by concurrent readers, so it is never freed.
+		// Capacity is doubled on every growth, so the leaked memory is always less than the size of the current index
+		void grow(Shard& shard)
+		{
+			Index* old_index = shard.index.load(etl::memory_order_relaxed);
+			Index* new_index = Index::create(old_index ? (old_index->mask + 1) * 2 : s_min_capacity);
+
+			if (old_index)
+			{
+				for (u32 slot = 0; slot <= old_index->mask; ++slot)
+				{
+					const u64 value = old_index->slots[slot].load(etl::memory_order_relaxed);
+
+					if (value != 0)
+					{
+						const u32 entry_index = unpack(value);
+						insert(new_index, entry(entry_index).hash, entry_index);
+					}
+				}
+			}
+
+			shard.index.store(new_index, etl::memory_order_release);
+		}
+
+	public:
+		static NameTable& instance()
+		{
+			// Table is never destroyed, names are used during static destruction too
+			alignas(NameTable) static u8 storage[sizeof(NameTable)];
+			static NameTable* table = new (storage) NameTable();
+			return *table;
+		}
+
+		FORCE_INLINE const Name::Entry& entry(u32 index) const
+		{
+			return m_chunks[index >> s_chunk_bits].load(etl::memory_order_acquire)[index & (s_chunk_size - 1)];
+		}
+
+		u32 find(const StringView& name, u64 hash)
+		{
+			Index* index = shard(hash).index.load(etl::memory_order_acquire);
+			return index ? find(index, name, hash) : Name::invalid_index;
+		}
+
+		u32 find_or_add(const StringView& name, u64 hash)
+		{
+			u32 result = find(name, hash);
+
+			if (result != Name::invalid_index)
+				return result;
+
+			Shard& target = shard(hash);
+			ScopeLock lock(target.cs);
+
+			// Other thread could add the same name before the lock was taken
+			Index* index = target.index.load(etl::memory_order_relaxed);
+
+			if (index && (result = find(index, name, hash)) != Name::invalid_index)
+				return result;
+
+			if (index == nullptr || (target.size + 1) * 4 > (index->mask + 1) * 3)
+			{
+				grow(target);
+				index = target.index.load(etl::memory_order_relaxed);
+			}
+
+			result = m_count.fetch_add(1, etl::memory_order_relaxed);
+			trinex_verify_msg(result < s_max_chunks * s_chunk_size, "Name table overflow");
+
+			new (chunk(result >> s_chunk_bits) + (result & (s_chunk_size - 1))) Name::Entry{String(name), hash};
+
+			insert(index, hash, result);
+			++target.size;
+			return result;
+		}
+
+		u32 count() const { return m_count.load(etl::memory_order_relaxed); }
+	};
 
 	static const String& default_string()
 	{
@@ -48,10 +211,9 @@ namespace Trinex
 		return default_name;
 	}
 
-	static FORCE_INLINE void push_new_name(const char* name, usize len, u64 hash)
+	static FORCE_INLINE u64 name_hash(const StringView& name)
 	{
-		name_index_map().insert({hash, name_entries().size()});
-		name_entries().push_back(Name::Entry{String(name, len), hash});
+		return memory_hash_fast(name.data(), name.length());
 	}
 
 	ENGINE_EXPORT Name Name::none;
@@ -59,66 +221,31 @@ namespace Trinex
 	Name Name::find_name(const StringView& name)
 	{
 		Name out_name;
-		u64 hash = memory_hash(name.data(), name.length(), 0);
-
-		Vector<Name::Entry>& name_table = name_entries();
-
-		out_name.m_index = name_table.size();
-
-		for (usize index = 0; index < out_name.m_index; ++index)
-		{
-			const Name::Entry& entry = name_table[index];
 
-			if (entry.hash == hash)
-			{
-				out_name.m_index = index;
-				return out_name;
-			}
-		}
+		if (!name.empty())
+			out_name.m_index = NameTable::instance().find(name, name_hash(name));
 
-		out_name.m_index = 0xFFFFFFFF;
 		return out_name;
 	}
 
 	usize Name::static_count()
 	{
-		return name_entries().size();
+		return NameTable::instance().count();
 	}
 
 	Name& Name::init(const StringView& view)
 	{
 		if (view.empty())
 		{
-			m_index = 0xFFFFFFFF;
+			m_index = invalid_index;
 			return *this;
 		}
 
-		u64 hash                        = memory_hash(view.data(), view.length(), 0);
-		Vector<Name::Entry>& name_table = name_entries();
-		MultiMap<u64, usize>& indices   = name_index_map();
-
-		m_index = name_table.size();
-
-		auto range = indices.equal_range(hash);
-
-		while (range.first != range.second)
-		{
-			usize index = range.first->second;
-
-			if (name_table[index].name == view)
-			{
-				m_index = index;
-				return *this;
-			}
-
-			++range.first;
-		}
-
-		push_new_name(view.data(), view.length(), hash);
+		m_index = NameTable::instance().find_or_add(view, name_hash(view));
 		return *this;
 	}
 
-	Name::Name() : m_index(0xFFFFFFFF) {}
+	Name::Name() : m_index(invalid_index) {}
 
 	Name::Name(const char* name) : Name(StringView(name)) {}
 
@@ -154,7 +281,7 @@ namespace Trinex
 
 	u64 Name::hash() const
 	{
-		return is_valid() ? name_entries()[m_index].hash : Constants::invalid_hash;
+		return is_valid() ? NameTable::instance().entry(m_index).hash : Constants::invalid_hash;
 	}
 
 	bool Name::operator==(const StringView& name) const
@@ -206,7 +333,7 @@ namespace Trinex
 	{
 		if (is_valid())
 		{
-			const String& str = name_entries()[m_index].name;
+			const String& str = NameTable::instance().entry(m_index).name;
 			return str == name;
 		}
 
@@ -223,7 +350,7 @@ namespace Trinex
 	{
 		if (is_valid())
 		{
-			out += name_entries()[m_index].name;
+			out += NameTable::instance().entry(m_index).name;
 		}
 
 		return *this;
@@ -233,7 +360,7 @@ namespace Trinex
 	{
 		if (is_valid())
 		{
-			return name_entries()[m_index].name;
+			return NameTable::instance().entry(m_index).name;
 		}
 
 		return default_string();
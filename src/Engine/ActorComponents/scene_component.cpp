@@ -28,7 +28,7 @@ namespace Trinex
 		return childs[index];
 	}
 
-	trinex_implement_engine_class(SceneComponent, Refl::Class::IsScriptable)
+	trinex_implement_engine_class(SceneComponent, Refl::Class::IsScriptable | Refl::Class::IsPooled)
 	{
 		trinex_refl_virtual_prop(Is Visible, is_visible, is_visible);
 
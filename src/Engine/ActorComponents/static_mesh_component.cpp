@@ -38,7 +38,7 @@ namespace Trinex
 	}
 
 
-	trinex_implement_engine_class(StaticMeshComponent, Refl::Class::IsScriptable)
+	trinex_implement_engine_class(StaticMeshComponent, Refl::Class::IsScriptable | Refl::Class::IsPooled)
 	{
 		trinex_refl_virtual_prop(mesh, mesh, mesh)->tooltip("Mesh object of this component");
 
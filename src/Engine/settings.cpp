@@ -3,15 +3,18 @@
 
 namespace Trinex::Settings
 {
-	ENGINE_EXPORT String engine_class        = "Trinex::BaseEngine";
-	ENGINE_EXPORT String default_language    = "eng";
-	ENGINE_EXPORT String current_language    = "eng";
-	ENGINE_EXPORT u32 num_threads            = 0;
-	ENGINE_EXPORT i32 lz4_compression_level  = 0;
-	ENGINE_EXPORT i32 gc_max_object_per_tick = 1;
-	ENGINE_EXPORT i32 fps_limit              = 60;
-	ENGINE_EXPORT float screen_percentage    = 1.f;
-	ENGINE_EXPORT Vector<String> languages   = {"eng"};
+	ENGINE_EXPORT String engine_class             = "Trinex::BaseEngine";
+	ENGINE_EXPORT String default_language         = "eng";
+	ENGINE_EXPORT String current_language         = "eng";
+	ENGINE_EXPORT u32 num_threads                 = 0;
+	ENGINE_EXPORT i32 lz4_compression_level       = 0;
+	ENGINE_EXPORT u32 lz4_block_size              = 256 * 1024;
+	ENGINE_EXPORT float gc_time_budget            = 1.f;
+	ENGINE_EXPORT u32 gc_mark_threads             = 0;
+	ENGINE_EXPORT i32 fps_limit                   = 60;
+	ENGINE_EXPORT float low_priority_tasks_budget = 0.f;
+	ENGINE_EXPORT float screen_percentage         = 1.f;
+	ENGINE_EXPORT Vector<String> languages        = {"eng"};
 	ENGINE_EXPORT Vector<String> systems;
 	ENGINE_EXPORT Vector<String> plugins;
 	ENGINE_EXPORT bool debug_shaders = false;
@@ -26,6 +29,7 @@ namespace Trinex::Settings
 		ENGINE_EXPORT bool force_keep_cpu_resources = false;
 		ENGINE_EXPORT u32 shadow_map_size           = 1024;
 		ENGINE_EXPORT float anisotropy              = 8.f;
+		ENGINE_EXPORT u32 frames_in_flight          = 2;
 	}// namespace Rendering
 
 	namespace Window
@@ -71,8 +75,11 @@ namespace Trinex::Settings
 			bind_value(string, current_language);
 			bind_value(uint, num_threads);
 			bind_value(int, lz4_compression_level);
-			bind_value(int, gc_max_object_per_tick);
+			bind_value(uint, lz4_block_size);
+			bind_value(float, gc_time_budget);
+			bind_value(uint, gc_mark_threads);
 			bind_value(float, fps_limit);
+			bind_value(float, low_priority_tasks_budget);
 			bind_value(Trinex::Vector<string>, languages);
 			bind_value(Trinex::Vector<string>, systems);
 			bind_value(Trinex::Vector<string>, plugins);
@@ -86,6 +93,7 @@ namespace Trinex::Settings
 
 			bind_value(string, rhi);
 			bind_value(uint, shadow_map_size);
+			bind_value(uint, frames_in_flight);
 		}
 
 		{
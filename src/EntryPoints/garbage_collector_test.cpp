@@ -0,0 +1,269 @@
+#include <Core/entry_point.hpp>
+#include <Core/etl/vector.hpp>
+#include <Core/garbage_collector.hpp>
+#include <Core/log.hpp>
+#include <Core/object_handle.hpp>
+#include <Core/package.hpp>
+#include <Core/reflection/class.hpp>
+#include <Core/reflection/property.hpp>
+#include <Core/reflection/struct.hpp>
+#include <Engine/settings.hpp>
+
+namespace Trinex
+{
+	struct GCTestLink {
+		trinex_struct(GCTestLink, void);
+
+		Object* target = nullptr;
+		Vector<GCTestLink> nested;
+	};
+
+	class GCTestNode : public Object
+	{
+		trinex_class(GCTestNode, Object);
+
+	public:
+		Object* ref = nullptr;
+		Vector<Object*> refs;
+		GCTestLink link;
+		Vector<Vector<Object*>> grid;
+
+		// Isn't reflected, so the collector doesn't see this reference
+		Object* hidden = nullptr;
+	};
+
+	trinex_implement_struct(Trinex::GCTestLink, 0)
+	{
+		trinex_refl_prop(target);
+		trinex_refl_prop(nested);
+	}
+
+	trinex_implement_class(Trinex::GCTestNode, 0)
+	{
+		trinex_refl_prop(ref);
+		trinex_refl_prop(refs);
+		trinex_refl_prop(link);
+		trinex_refl_prop(grid);
+	}
+
+	// Headless garbage collector test.
+	// Builds object graphs which aren't referenced by the engine and checks which objects are marked and which are destroyed
+	// by full and time-sliced cycles, including graph changes made between the steps of a cycle.
+	// Objects of other types are kept alive through GarbageCollector::on_unreachable_check while the test is running.
+	//
+	// Usage: --entry=GarbageCollectorTest
+	class GarbageCollectorTest : public EntryPoint
+	{
+		trinex_class(GarbageCollectorTest, EntryPoint);
+
+	private:
+		static GCTestNode* node() { return Object::new_instance<GCTestNode>(); }
+
+		static void keep_foreign_objects(Object* object)
+		{
+			if (!object->class_instance()->is_a(GCTestNode::static_reflection()))
+				object->flags.remove(Object::Flags::IsUnreachable);
+		}
+
+		static void verify_alive(const Vector<ObjectHandle>& handles, const char* scenario)
+		{
+			for (const ObjectHandle& handle : handles)
+			{
+				trinex_verify_fmt(handle.is_valid(), "%s: reachable object was destroyed", scenario);
+				trinex_verify_fmt(GarbageCollector::is_marked(handle.object()), "%s: reachable object wasn't marked", scenario);
+				trinex_verify_fmt(!handle.object()->flags.all(Object::Flags::IsUnreachable),
+				                  "%s: reachable object is flagged as unreachable", scenario);
+			}
+		}
+
+		static void verify_destroyed(const Vector<ObjectHandle>& handles, const char* scenario)
+		{
+			for (const ObjectHandle& handle : handles)
+			{
+				trinex_verify_fmt(!handle.is_valid(), "%s: unreachable object wasn't destroyed", scenario);
+			}
+		}
+
+		static void finish_cycle()
+		{
+			while (GarbageCollector::is_collecting()) GarbageCollector::update(0.f);
+		}
+
+		// Cycles, arrays, nested structs, referenced and owned roots
+		static void test_reachability()
+		{
+			GCTestNode* root = node();
+			root->add_reference();
+
+			GCTestNode* cycle_a = node();
+			GCTestNode* cycle_b = node();
+			root->ref           = cycle_a;
+			cycle_a->ref        = cycle_b;
+			cycle_b->ref        = cycle_a;
+
+			GCTestNode* array_a = node();
+			GCTestNode* array_b = node();
+			root->refs          = {array_a, nullptr, array_b};
+
+			GCTestNode* grid = node();
+			root->grid       = {{}, {nullptr, grid}};
+
+			GCTestNode* link   = node();
+			GCTestNode* nested = node();
+			GCTestNode* deep   = node();
+			root->link.target  = link;
+			root->link.nested.resize(2);
+			root->link.nested[1].target = nested;
+			root->link.nested[0].nested.resize(1);
+			root->link.nested[0].nested[0].target = deep;
+
+			// Object reached only through a nested struct of another reachable object
+			GCTestNode* indirect = node();
+			nested->link.nested.resize(1);
+			nested->link.nested[0].target = indirect;
+
+			Package* package = Object::static_find_package("GCTest", true);
+			GCTestNode* owned = Object::new_instance<GCTestNode>("Owned", package);
+			GCTestNode* child = node();
+			owned->ref        = child;
+
+			GCTestNode* lost_a = node();
+			GCTestNode* lost_b = node();
+			lost_a->ref        = lost_b;
+			lost_b->ref        = lost_a;
+
+			GCTestNode* garbage      = node();
+			GCTestNode* garbage_leaf = node();
+			garbage->link.nested.resize(1);
+			garbage->link.nested[0].target = garbage_leaf;
+
+			GCTestNode* hidden = node();
+			root->hidden       = hidden;
+
+			// Wide graph, large enough to be marked in parallel by a full collection
+			Vector<ObjectHandle> wide;
+
+			for (usize i = 0; i < 4096; ++i)
+			{
+				GCTestNode* item = node();
+				item->ref        = node();
+				root->refs.push_back(item);
+				wide.push_back(item);
+				wide.push_back(item->ref);
+			}
+
+			Vector<ObjectHandle> reachable = {root,   cycle_a,  cycle_b, array_a, array_b, grid, link,
+			                                  nested, indirect, deep,    owned,   child};
+			Vector<ObjectHandle> unreachable = {lost_a, lost_b, garbage, garbage_leaf, hidden};
+
+			GarbageCollector::collect();
+
+			verify_alive(reachable, "Reachability");
+			verify_alive(wide, "Reachability");
+			verify_destroyed(unreachable, "Reachability");
+
+			// Everything except the owned object and its child is reachable only from the root
+			root->hidden = nullptr;
+			root->remove_reference();
+			GarbageCollector::collect();
+
+			verify_alive({owned, child}, "Released root");
+			verify_destroyed({root, cycle_a, cycle_b, array_a, array_b, grid, link, nested, indirect, deep}, "Released root");
+			verify_destroyed(wide, "Released root");
+
+			owned->owner(nullptr);
+			GarbageCollector::collect();
+			verify_destroyed({owned, child}, "Released owner");
+		}
+
+		// Graph changes between the steps of a time-sliced cycle
+		static void test_incremental()
+		{
+			static constexpr usize chain_length = 20000;
+
+			const float budget       = Settings::gc_time_budget;
+			Settings::gc_time_budget = 0.001f;
+
+			GCTestNode* root = node();
+			root->add_reference();
+
+			// Chain is scanned strictly in order, so the marked links show how far marking went
+			Vector<GCTestNode*> chain;
+			chain.push_back(node());
+			root->ref = chain.back();
+
+			for (usize i = 1; i < chain_length; ++i)
+			{
+				chain.push_back(node());
+				chain[i - 1]->ref = chain.back();
+			}
+
+			GCTestNode* moved    = node();
+			GCTestNode* released = node();
+			chain.back()->refs   = {moved};
+			root->refs           = {released};
+
+			GarbageCollector::update(0.f);
+
+			while (GarbageCollector::is_collecting() && !GarbageCollector::is_marked(chain[chain_length / 4]))
+				GarbageCollector::update(0.f);
+
+			trinex_verify_msg(GarbageCollector::is_collecting() && !GarbageCollector::is_marked(chain.back()),
+			                  "Incremental: cycle finished in too few steps");
+
+			// Root is already scanned, storing into it requires the barrier
+			root->refs.push_back(moved);
+			GarbageCollector::write_barrier(moved);
+			chain.back()->refs.clear();
+
+			// Objects created while marking are scanned before the sweep
+			GCTestNode* created = node();
+			root->refs.push_back(created);
+
+			// Already marked object stays alive until the next cycle
+			root->refs.erase(root->refs.begin());
+
+			// The rest of the chain isn't marked yet
+			const usize cut = chain_length / 2;
+			chain[cut]->ref = nullptr;
+
+			Vector<ObjectHandle> head(chain.begin(), chain.begin() + cut + 1);
+			Vector<ObjectHandle> tail(chain.begin() + cut + 1, chain.end());
+
+			finish_cycle();
+
+			verify_alive(head, "Incremental");
+			verify_alive({root, moved, created, released}, "Incremental");
+			verify_destroyed(tail, "Incremental");
+
+			GarbageCollector::update(0.f);
+			finish_cycle();
+
+			verify_alive({root, moved, created}, "Incremental");
+			verify_destroyed({released}, "Incremental");
+
+			root->remove_reference();
+			GarbageCollector::collect();
+			verify_destroyed(head, "Incremental");
+			verify_destroyed({root, moved, created}, "Incremental");
+
+			Settings::gc_time_budget = budget;
+		}
+
+	public:
+		i32 execute() override
+		{
+			auto id = GarbageCollector::on_unreachable_check.push(keep_foreign_objects);
+
+			test_reachability();
+			test_incremental();
+
+			GarbageCollector::on_unreachable_check.remove(id);
+
+			trinex_info(Log::Core, "Garbage collector test passed");
+			return 0;
+		}
+	};
+
+	trinex_implement_class_default_init(GarbageCollectorTest, 0);
+}// namespace Trinex
@@ -0,0 +1,155 @@
+#include <Core/arguments.hpp>
+#include <Core/entry_point.hpp>
+#include <Core/etl/map.hpp>
+#include <Core/etl/string.hpp>
+#include <Core/etl/vector.hpp>
+#include <Core/log.hpp>
+#include <Core/math/math.hpp>
+#include <Core/reflection/class.hpp>
+#include <Core/string_functions.hpp>
+#include <chrono>
+#include <cstdlib>
+
+namespace Trinex
+{
+	// Headless hash map benchmark.
+	// Compares FlatHashMap, which is used as Map, with the node based std::unordered_map on integer and string keys.
+	//
+	// Usage: --entry=HashMapBenchmark [--count=1000000] [--rounds=3]
+	class HashMapBenchmark : public EntryPoint
+	{
+		trinex_class(HashMapBenchmark, EntryPoint);
+
+	private:
+		struct Timings {
+			f64 insert  = 0.0;
+			f64 hit     = 0.0;
+			f64 miss    = 0.0;
+			f64 iterate = 0.0;
+			f64 erase   = 0.0;
+			usize check = 0;
+		};
+
+		static usize argument(const char* name, usize default_value)
+		{
+			auto arg = Arguments::find(name);
+
+			if (arg && arg->type == Arguments::Type::String)
+				return std::strtoull(arg->get<const String&>().c_str(), nullptr, 10);
+
+			return default_value;
+		}
+
+		template<typename Callable>
+		static f64 measure(Callable&& callable)
+		{
+			auto start = std::chrono::steady_clock::now();
+			callable();
+			return std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - start).count();
+		}
+
+		template<typename MapType, typename Key>
+		static Timings run(const Vector<Key>& keys, const Vector<Key>& missing)
+		{
+			Timings timings;
+			MapType map;
+
+			timings.insert = measure([&]() {
+				for (usize i = 0; i < keys.size(); ++i) map[keys[i]] = i;
+			});
+
+			timings.hit = measure([&]() {
+				for (const Key& key : keys) timings.check += map.find(key)->second;
+			});
+
+			timings.miss = measure([&]() {
+				for (const Key& key : missing) timings.check += map.find(key) == map.end();
+			});
+
+			timings.iterate = measure([&]() {
+				for (auto& [key, value] : map) timings.check += value;
+			});
+
+			timings.erase = measure([&]() {
+				for (const Key& key : keys) timings.check += map.erase(key);
+			});
+
+			return timings;
+		}
+
+		template<typename Key>
+		static void compare(const char* name, const Vector<Key>& keys, const Vector<Key>& missing, usize rounds)
+		{
+			Timings flat;
+			Timings node;
+
+			for (usize round = 0; round < rounds; ++round)
+			{
+				Timings current_flat = run<FlatHashMap<Key, usize>>(keys, missing);
+				Timings current_node = run<NodeMap<Key, usize>>(keys, missing);
+
+				if (round == 0 || current_flat.insert + current_flat.hit < flat.insert + flat.hit)
+					flat = current_flat;
+
+				if (round == 0 || current_node.insert + current_node.hit < node.insert + node.hit)
+					node = current_node;
+			}
+
+			trinex_verify_msg(flat.check == node.check, "FlatHashMap and NodeMap produced different results");
+
+			auto report = [name](const char* operation, f64 flat_time, f64 node_time) {
+				trinex_info(Log::Core, "%-8s %-8s | FlatHashMap %9.2f ms | std::unordered_map %9.2f ms | x%.2f", name, operation,
+				            flat_time, node_time, node_time / flat_time);
+			};
+
+			report("insert", flat.insert, node.insert);
+			report("hit", flat.hit, node.hit);
+			report("miss", flat.miss, node.miss);
+			report("iterate", flat.iterate, node.iterate);
+			report("erase", flat.erase, node.erase);
+		}
+
+	public:
+		i32 execute() override
+		{
+			const usize count  = Math::max<usize>(argument("count", 1000000), 1);
+			const usize rounds = Math::max<usize>(argument("rounds", 3), 1);
+
+			trinex_info(Log::Core, "Hash map benchmark: %zu keys, best of %zu rounds", count, rounds);
+
+			Vector<u64> integers(count);
+			Vector<u64> missing_integers(count);
+			u64 seed = 0x9E3779B97F4A7C15ULL;
+
+			auto next = [&seed]() {
+				seed ^= seed << 13;
+				seed ^= seed >> 7;
+				seed ^= seed << 17;
+				return seed;
+			};
+
+			// Even keys are inserted, odd keys are used to measure failed lookups
+			for (usize i = 0; i < count; ++i)
+			{
+				integers[i]         = next() & ~u64(1);
+				missing_integers[i] = next() | u64(1);
+			}
+
+			compare("u64", integers, missing_integers, rounds);
+
+			Vector<String> strings(count);
+			Vector<String> missing_strings(count);
+
+			for (usize i = 0; i < count; ++i)
+			{
+				strings[i]         = Strings::format("Object_{}", integers[i]);
+				missing_strings[i] = Strings::format("Object_{}", missing_integers[i]);
+			}
+
+			compare("String", strings, missing_strings, rounds);
+			return 0;
+		}
+	};
+
+	trinex_implement_class_default_init(HashMapBenchmark, 0);
+}// namespace Trinex
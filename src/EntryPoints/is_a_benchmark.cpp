@@ -0,0 +1,172 @@
+#include <Core/arguments.hpp>
+#include <Core/entry_point.hpp>
+#include <Core/etl/vector.hpp>
+#include <Core/log.hpp>
+#include <Core/math/math.hpp>
+#include <Core/reflection/class.hpp>
+#include <Core/reflection/scoped_type.hpp>
+#include <chrono>
+#include <cstdlib>
+
+namespace Trinex
+{
+	// Headless Refl::Struct::is_a benchmark.
+	// Compares the interval test of the hierarchy numbering with the parent chain walk on random pairs of all registered
+	// structs and checks that both produce the same answer.
+	//
+	// Usage: --entry=IsABenchmark [--queries=10000000] [--rounds=3]
+	class IsABenchmark : public EntryPoint
+	{
+		trinex_class(IsABenchmark, EntryPoint);
+
+	private:
+		static usize argument(const char* name, usize default_value)
+		{
+			auto arg = Arguments::find(name);
+
+			if (arg && arg->type == Arguments::Type::String)
+				return std::strtoull(arg->get<const String&>().c_str(), nullptr, 10);
+
+			return default_value;
+		}
+
+		template<typename Callable>
+		static f64 measure(Callable&& callable)
+		{
+			auto start = std::chrono::steady_clock::now();
+			callable();
+			return std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - start).count();
+		}
+
+		static void collect(Refl::Object* object, Vector<Refl::Struct*>& structs)
+		{
+			if (auto self = Refl::Object::instance_cast<Refl::Struct>(object))
+				structs.push_back(self);
+
+			if (auto scope = Refl::Object::instance_cast<Refl::ScopedType>(object))
+			{
+				for (auto& [name, child] : scope->childs())
+				{
+					if (child)
+						collect(child, structs);
+				}
+			}
+		}
+
+		static bool is_a_walk(const Refl::Struct* self, const Refl::Struct* other)
+		{
+			while (self && self != other) self = self->parent();
+			return self != nullptr;
+		}
+
+		static usize depth(const Refl::Struct* self)
+		{
+			usize result = 0;
+			while ((self = self->parent())) ++result;
+			return result;
+		}
+
+	public:
+		i32 execute() override
+		{
+			const usize queries = Math::max<usize>(argument("queries", 10000000), 1);
+			const usize rounds  = Math::max<usize>(argument("rounds", 3), 1);
+
+			Vector<Refl::Struct*> structs;
+			collect(Refl::Object::static_root(), structs);
+
+			if (structs.empty())
+			{
+				trinex_error(Log::Core, "No reflected structs found");
+				return -1;
+			}
+
+			usize max_depth   = 0;
+			usize total_depth = 0;
+
+			for (Refl::Struct* self : structs)
+			{
+				const usize current = depth(self);
+				max_depth           = Math::max(max_depth, current);
+				total_depth += current;
+			}
+
+			trinex_info(Log::Core, "Is-a benchmark: %zu structs, max depth %zu, average depth %.2f, %zu queries, best of %zu rounds",
+			            structs.size(), max_depth, static_cast<f64>(total_depth) / structs.size(), queries, rounds);
+
+			// Every struct is checked against every other one for correctness
+			usize mismatches = 0;
+
+			for (Refl::Struct* self : structs)
+			{
+				for (Refl::Struct* other : structs)
+				{
+					mismatches += self->is_a(other) != is_a_walk(self, other);
+				}
+			}
+
+			trinex_verify_msg(mismatches == 0, "Interval is_a differs from the parent chain walk");
+
+			// Queries are biased to the deepest structs against their ancestors, which is the worst case of the walk
+			Vector<Refl::Struct*> deep;
+
+			for (Refl::Struct* self : structs)
+			{
+				if (depth(self) + 2 >= max_depth)
+					deep.push_back(self);
+			}
+
+			Vector<std::pair<const Refl::Struct*, const Refl::Struct*>> pairs(queries);
+			u64 seed = 0x9E3779B97F4A7C15ULL;
+
+			auto next = [&seed]() {
+				seed ^= seed << 13;
+				seed ^= seed >> 7;
+				seed ^= seed << 17;
+				return seed;
+			};
+
+			for (auto& [self, other] : pairs)
+			{
+				self  = deep[next() % deep.size()];
+				other = structs[next() % structs.size()];
+			}
+
+			f64 interval_time = 0.0;
+			f64 walk_time     = 0.0;
+			usize interval    = 0;
+			usize walk        = 0;
+
+			for (usize round = 0; round < rounds; ++round)
+			{
+				usize current_interval = 0;
+				usize current_walk     = 0;
+
+				f64 current_interval_time = measure([&]() {
+					for (auto& [self, other] : pairs) current_interval += self->is_a(other);
+				});
+
+				f64 current_walk_time = measure([&]() {
+					for (auto& [self, other] : pairs) current_walk += is_a_walk(self, other);
+				});
+
+				if (round == 0 || current_interval_time < interval_time)
+					interval_time = current_interval_time;
+
+				if (round == 0 || current_walk_time < walk_time)
+					walk_time = current_walk_time;
+
+				interval = current_interval;
+				walk     = current_walk;
+			}
+
+			trinex_verify_msg(interval == walk, "Interval is_a differs from the parent chain walk");
+
+			trinex_info(Log::Core, "is_a | interval %9.2f ms | parent walk %9.2f ms | x%.2f | %zu positive", interval_time,
+			            walk_time, walk_time / interval_time, interval);
+			return 0;
+		}
+	};
+
+	trinex_implement_class_default_init(IsABenchmark, 0);
+}// namespace Trinex
@@ -0,0 +1,397 @@
+#include <Core/arguments.hpp>
+#include <Core/entry_point.hpp>
+#include <Core/etl/allocator.hpp>
+#include <Core/etl/concurrent_queue.hpp>
+#include <Core/etl/critical_section.hpp>
+#include <Core/etl/deque.hpp>
+#include <Core/etl/vector.hpp>
+#include <Core/etl/work_stealing_deque.hpp>
+#include <Core/log.hpp>
+#include <Core/math/math.hpp>
+#include <Core/memory_tracker.hpp>
+#include <Core/parallel.hpp>
+#include <Core/reflection/class.hpp>
+#include <Core/threading.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <numeric>
+
+namespace Trinex
+{
+	// Headless scheduler throughput benchmark.
+	// Compares the legacy single mutex + condition variable queue with per-worker work-stealing deques
+	// on a fork-join workload: the caller injects root jobs, every root job spawns children on the executing worker.
+	// Before measuring, verifies that steady state task submission and frame allocations don't touch the heap,
+	// and that parallel reduce, scan and sort give the same results as the standard algorithms.
+	//
+	// Usage: --entry=TaskGraphBenchmark [--threads=64] [--jobs=200000] [--work=64]
+	class TaskGraphBenchmark : public EntryPoint
+	{
+		trinex_class(TaskGraphBenchmark, EntryPoint);
+
+	private:
+		static constexpr u32 s_fanout = 16;
+
+		struct Job {
+			u32 children;
+		};
+
+		static inline void payload(u32 work)
+		{
+			volatile u32 value = 0;
+			for (u32 i = 0; i < work; ++i) value = value + i;
+		}
+
+		static usize argument(const char* name, usize default_value)
+		{
+			auto arg = Arguments::find(name);
+
+			if (arg && arg->type == Arguments::Type::String)
+				return std::strtoull(arg->get<const String&>().c_str(), nullptr, 10);
+
+			return default_value;
+		}
+
+		struct LegacyScheduler {
+			Deque<Job> m_queue;
+			std::mutex m_mutex;
+			std::condition_variable m_cv;
+			Atomic<usize> m_executed = 0;
+			bool m_stop              = false;
+			u32 m_work               = 0;
+
+			void push(Job job)
+			{
+				{
+					std::unique_lock lock(m_mutex);
+					m_queue.push_back(job);
+				}
+				m_cv.notify_one();
+			}
+
+			static void worker_main(void* data)
+			{
+				LegacyScheduler* self = static_cast<LegacyScheduler*>(data);
+
+				while (true)
+				{
+					Job job;
+					{
+						std::unique_lock lock(self->m_mutex);
+						self->m_cv.wait(lock, [self] { return self->m_stop || !self->m_queue.empty(); });
+
+						if (self->m_stop)
+							return;
+
+						job = self->m_queue.front();
+						self->m_queue.pop_front();
+					}
+
+					for (u32 i = 0; i < job.children; ++i) self->push(Job{0});
+
+					payload(self->m_work);
+					self->m_executed.fetch_add(1, etl::memory_order_relaxed);
+				}
+			}
+
+			void stop()
+			{
+				{
+					std::unique_lock lock(m_mutex);
+					m_stop = true;
+				}
+				m_cv.notify_all();
+			}
+		};
+
+		struct StealingScheduler {
+			struct Worker {
+				StealingScheduler* m_scheduler;
+				WorkStealingDeque<Job> m_queue;
+				u32 m_seed;
+
+				Worker(StealingScheduler* scheduler, u32 seed) : m_scheduler(scheduler), m_seed(seed) {}
+			};
+
+			Vector<Worker*> m_workers;
+			ConcurrentQueue<Job> m_injection;
+			Atomic<usize> m_executed = 0;
+			Atomic<bool> m_stop      = false;
+			u32 m_work               = 0;
+
+			StealingScheduler(usize jobs) : m_injection(jobs) {}
+
+			bool find(Worker* self, Job& job)
+			{
+				if (self->m_queue.pop(job) || m_injection.pop(job))
+					return true;
+
+				self->m_seed ^= self->m_seed << 13;
+				self->m_seed ^= self->m_seed >> 17;
+				self->m_seed ^= self->m_seed << 5;
+
+				const usize count = m_workers.size();
+
+				for (usize i = 0; i < count; ++i)
+				{
+					Worker* victim = m_workers[(self->m_seed + i) % count];
+
+					if (victim != self && victim->m_queue.steal(job))
+						return true;
+				}
+
+				return false;
+			}
+
+			static void worker_main(void* data)
+			{
+				Worker* self                 = static_cast<Worker*>(data);
+				StealingScheduler* scheduler = self->m_scheduler;
+
+				while (!scheduler->m_stop.load(etl::memory_order_relaxed))
+				{
+					Job job;
+
+					if (!scheduler->find(self, job))
+					{
+						Thread::static_yield();
+						continue;
+					}
+
+					for (u32 i = 0; i < job.children; ++i) self->m_queue.push(Job{0});
+
+					payload(scheduler->m_work);
+					scheduler->m_executed.fetch_add(1, etl::memory_order_relaxed);
+				}
+			}
+		};
+
+		static f64 run_legacy(u32 threads, usize roots, u32 work)
+		{
+			LegacyScheduler scheduler;
+			scheduler.m_work = work;
+
+			Vector<Thread*> workers;
+			for (u32 i = 0; i < threads; ++i) workers.push_back(trx_new Thread(LegacyScheduler::worker_main, &scheduler));
+
+			const usize total = roots * (s_fanout + 1);
+			auto start        = std::chrono::steady_clock::now();
+
+			for (usize i = 0; i < roots; ++i) scheduler.push(Job{s_fanout});
+			while (scheduler.m_executed.load(etl::memory_order_relaxed) < total) Thread::static_yield();
+
+			auto end = std::chrono::steady_clock::now();
+			scheduler.stop();
+
+			for (Thread* worker : workers) trx_delete worker;
+			return std::chrono::duration<f64>(end - start).count();
+		}
+
+		static f64 run_stealing(u32 threads, usize roots, u32 work)
+		{
+			StealingScheduler scheduler(roots);
+			scheduler.m_work = work;
+
+			for (u32 i = 0; i < threads; ++i)
+				scheduler.m_workers.push_back(trx_new StealingScheduler::Worker(&scheduler, 0x9E3779B9U * (i + 1)));
+
+			Vector<Thread*> workers;
+			for (auto* worker : scheduler.m_workers) workers.push_back(trx_new Thread(StealingScheduler::worker_main, worker));
+
+			const usize total = roots * (s_fanout + 1);
+			auto start        = std::chrono::steady_clock::now();
+
+			for (usize i = 0; i < roots; ++i) scheduler.m_injection.push(Job{s_fanout});
+			while (scheduler.m_executed.load(etl::memory_order_relaxed) < total) Thread::static_yield();
+
+			auto end = std::chrono::steady_clock::now();
+			scheduler.m_stop.store(true);
+
+			for (Thread* worker : workers) trx_delete worker;
+			for (auto* worker : scheduler.m_workers) trx_delete worker;
+			return std::chrono::duration<f64>(end - start).count();
+		}
+
+		static f64 run_task_graph(usize roots, u32 work)
+		{
+			TaskGraph* graph = TaskGraph::instance();
+			auto start       = std::chrono::steady_clock::now();
+
+			Task root([]() {});
+
+			for (usize i = 0; i < roots; ++i)
+			{
+				Task task([graph, work, root]() {
+					for (u32 j = 0; j < s_fanout; ++j)
+					{
+						Task child([work]() { payload(work); });
+						child.add_dependent(root);
+						graph->add_task(child);
+					}
+					payload(work);
+				});
+
+				task.add_dependent(root);
+				graph->add_task(task);
+			}
+
+			graph->wait_for(root);
+			return std::chrono::duration<f64>(std::chrono::steady_clock::now() - start).count();
+		}
+
+		// Submits count tasks which signal a common root. If hold is true, tasks are blocked by a gate until all of them are
+		// submitted, so every task object and dependency node is alive at the same time
+		static void run_tasks(usize count, u32 work, bool hold)
+		{
+			TaskGraph* graph = TaskGraph::instance();
+			Task root([]() {});
+			Task gate([]() {});
+
+			for (usize i = 0; i < count; ++i)
+			{
+				Task task([work]() { payload(work); });
+				task.add_dependent(root);
+
+				if (hold)
+					gate.add_dependent(task);
+
+				graph->add_task(task);
+			}
+
+			if (hold)
+				graph->add_task(gate);
+
+			graph->wait_for(root);
+		}
+
+		static void check_allocations(usize roots, u32 work)
+		{
+			static constexpr u32 passes = 4;
+
+			// Workers keep released objects in their local caches until a batch is collected, so the caches are filled
+			// with more objects than a single pass can keep alive
+			run_tasks(roots + 256 * (TaskGraph::instance()->workers() + 1), work, true);
+
+			const usize task_allocations = Task::heap_allocations();
+
+			for (u32 pass = 0; pass < passes; ++pass)
+			{
+				trinex_expect_allocations(0);
+				run_tasks(roots, work, false);
+			}
+
+			trinex_verify_fmt(Task::heap_allocations() == task_allocations, "Task submission performed %zu heap allocations",
+			                  Task::heap_allocations() - task_allocations);
+
+			auto fill_frame = []() {
+				FrameByteAllocator::reset();
+				FrameVector<u64> values;
+
+				for (u64 i = 0; i < 4096; ++i) values.push_back(i);
+			};
+
+			// Blocks of the frame allocator are reused once every slot of the ring was used
+			for (u32 frame = 0; frame < FrameByteAllocator::frames_in_flight(); ++frame) fill_frame();
+
+			for (u32 frame = 0; frame < FrameByteAllocator::frames_in_flight() * passes; ++frame)
+			{
+				trinex_expect_allocations(0);
+				fill_frame();
+			}
+
+			trinex_info(Log::Core, "Steady state task submission and frame allocations performed no heap allocations");
+		}
+
+		// Has no default constructor and many equal keys, so sort must move elements and keep the order of equal ones
+		struct SortItem {
+			u32 key;
+			u32 index;
+
+			SortItem(u32 key, u32 index) : key(key), index(index) {}
+			bool operator==(const SortItem& other) const { return key == other.key && index == other.index; }
+		};
+
+		static void check_parallel()
+		{
+			static constexpr usize sizes[] = {0, 1, 2, 255, 257, 1001, 4097, 100003};
+
+			auto equal = [](const auto& a, const auto& b) { return std::equal(a.begin(), a.end(), b.begin(), b.end()); };
+
+			u32 seed = 0x9E3779B9U;
+
+			for (usize size : sizes)
+			{
+				Vector<u64> values;
+				Vector<SortItem> items;
+
+				for (usize i = 0; i < size; ++i)
+				{
+					seed ^= seed << 13;
+					seed ^= seed >> 17;
+					seed ^= seed << 5;
+
+					values.push_back(seed);
+					items.emplace_back(seed % 97, static_cast<u32>(i));
+				}
+
+				const u64 sum          = Parallel::reduce(values.begin(), values.end(), u64(7));
+				const u64 expected_sum = std::accumulate(values.begin(), values.end(), u64(7));
+				trinex_verify_fmt(sum == expected_sum, "Parallel::reduce failed, %zu elements", size);
+
+				Vector<u64> expected(size);
+				Vector<u64> result(size);
+
+				std::inclusive_scan(values.begin(), values.end(), expected.begin());
+				Parallel::inclusive_scan(values.begin(), values.end(), result.begin());
+				trinex_verify_fmt(equal(result, expected), "Parallel::inclusive_scan failed, %zu elements", size);
+
+				result = values;
+				Parallel::inclusive_scan(result.begin(), result.end(), result.begin());
+				trinex_verify_fmt(equal(result, expected), "In place Parallel::inclusive_scan failed, %zu elements", size);
+
+				std::exclusive_scan(values.begin(), values.end(), expected.begin(), u64(7));
+				Parallel::exclusive_scan(values.begin(), values.end(), result.begin(), u64(7));
+				trinex_verify_fmt(equal(result, expected), "Parallel::exclusive_scan failed, %zu elements", size);
+
+				auto by_key = [](const SortItem& a, const SortItem& b) { return a.key < b.key; };
+
+				Vector<SortItem> sorted = items;
+				std::stable_sort(sorted.begin(), sorted.end(), by_key);
+				Parallel::sort(items.begin(), items.end(), by_key);
+				trinex_verify_fmt(equal(items, sorted), "Parallel::sort failed, %zu elements", size);
+			}
+
+			trinex_info(Log::Core, "Parallel reduce, scan and sort match the standard algorithms");
+		}
+
+	public:
+		i32 execute() override
+		{
+			const u32 max_threads = Math::clamp<u32>(argument("threads", 64), 1, 64);
+			const usize jobs      = Math::max<usize>(argument("jobs", 200000), s_fanout + 1);
+			const u32 work        = argument("work", 64);
+			const usize roots     = jobs / (s_fanout + 1);
+			const usize total     = roots * (s_fanout + 1);
+
+			trinex_info(Log::Core, "TaskGraph benchmark: %zu jobs, fan-out %u, payload %u", total, s_fanout, work);
+			check_allocations(roots, work);
+			check_parallel();
+
+			for (u32 threads = 1; threads <= max_threads; threads *= 2)
+			{
+				f64 legacy   = run_legacy(threads, roots, work);
+				f64 stealing = run_stealing(threads, roots, work);
+
+				trinex_info(Log::Core, "threads %2u | mutex queue %10.0f jobs/s | work stealing %10.0f jobs/s | x%.2f", threads,
+				            total / legacy, total / stealing, legacy / stealing);
+			}
+
+			f64 graph = run_task_graph(roots, work);
+			trinex_info(Log::Core, "TaskGraph (%u workers): %.0f jobs/s", TaskGraph::instance()->workers(), total / graph);
+			return 0;
+		}
+	};
+
+	trinex_implement_class_default_init(TaskGraphBenchmark, 0);
+}// namespace Trinex
@@ -251,7 +251,7 @@ namespace Trinex
 
 	u64 RHITexturePool::Hasher::operator()(const Key& key) const
 	{
-		return memory_hash(&key, sizeof(key));
+		return memory_hash_fast(&key, sizeof(key));
 	}
 
 	RHITexturePool* RHITexturePool::global_instance()
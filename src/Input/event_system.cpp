@@ -415,9 +415,9 @@ namespace Trinex
 		}
 	}
 
-	Vector<EventTarget*> EventDispatcher::build_route(EventTarget* target, EventTarget* routing_root) const
+	RoutedEvent::Route EventDispatcher::build_route(EventTarget* target, EventTarget* routing_root) const
 	{
-		Vector<EventTarget*> route;
+		RoutedEvent::Route route;
 		EventTarget* current = target;
 
 		while (current)
@@ -738,12 +738,12 @@ namespace Trinex
 		return false;
 	}
 
-	const Map<DeviceId, InputDeviceState>& InputSystem::device_states() const
+	const NodeMap<DeviceId, InputDeviceState>& InputSystem::device_states() const
 	{
 		return m_device_states;
 	}
 
-	const Map<DeviceId, InputDevice>& InputSystem::devices() const
+	const NodeMap<DeviceId, InputDevice>& InputSystem::devices() const
 	{
 		return m_devices;
 	}
@@ -8,8 +8,11 @@
 #include <android_native_app_glue.h>
 #include <android_platform.hpp>
 #include <errno.h>
+#include <fcntl.h>
 #include <jni.h>
+#include <sys/mman.h>
 #include <sys/random.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 
@@ -112,6 +115,49 @@ namespace Trinex::Platform
 		return info;
 	}
 
+	ENGINE_EXPORT const void* map_file(const Path& path, usize& size)
+	{
+		size   = 0;
+		int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+		if (fd < 0)
+			return nullptr;
+
+		struct stat info;
+
+		if (fstat(fd, &info) != 0 || info.st_size <= 0)
+		{
+			close(fd);
+			return nullptr;
+		}
+
+		void* data = mmap(nullptr, static_cast<usize>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+		close(fd);
+
+		if (data == MAP_FAILED)
+			return nullptr;
+
+		size = static_cast<usize>(info.st_size);
+		return data;
+	}
+
+	ENGINE_EXPORT void unmap_file(const void* data, usize size)
+	{
+		if (data)
+		{
+			munmap(const_cast<void*>(data), size);
+		}
+	}
+
+	ENGINE_EXPORT void advise_sequential_read(const void* data, usize size)
+	{
+		if (data)
+		{
+			madvise(const_cast<void*>(data), size, MADV_SEQUENTIAL);
+			madvise(const_cast<void*>(data), size, MADV_WILLNEED);
+		}
+	}
+
 	void initialize_android_application(struct android_app* app)
 	{
 		m_application = app;
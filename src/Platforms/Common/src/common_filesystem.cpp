@@ -123,7 +123,7 @@ namespace Trinex::VFS
 			open_mode |= std::ios_base::in;
 		if (mode & FileOpenMode::Write)
 			open_mode |= std::ios_base::out;
-		if (mode & FileOpenMode::Append)
+		if (mode.all(FileOpenMode::Append))
 			open_mode |= std::ios_base::app;
 
 		std::fstream file;
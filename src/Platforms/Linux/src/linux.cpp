@@ -4,7 +4,11 @@
 #include <Core/types/uuid.hpp>
 #include <Platform/platform.hpp>
 #include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/random.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 namespace Trinex::Platform
 {
@@ -53,4 +57,49 @@ namespace Trinex::Platform
 			return Path("./");
 		return Path(argv[0]).base_path();
 	}
+
+	ENGINE_EXPORT const void* map_file(const Path& path, usize& size)
+	{
+		size   = 0;
+		int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+		if (fd < 0)
+			return nullptr;
+
+		struct stat info;
+
+		if (fstat(fd, &info) != 0 || info.st_size <= 0)
+		{
+			close(fd);
+			return nullptr;
+		}
+
+		void* data = mmap(nullptr, static_cast<usize>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+		// Mapping stays valid after the descriptor is closed
+		close(fd);
+
+		if (data == MAP_FAILED)
+			return nullptr;
+
+		size = static_cast<usize>(info.st_size);
+		return data;
+	}
+
+	ENGINE_EXPORT void unmap_file(const void* data, usize size)
+	{
+		if (data)
+		{
+			munmap(const_cast<void*>(data), size);
+		}
+	}
+
+	ENGINE_EXPORT void advise_sequential_read(const void* data, usize size)
+	{
+		if (data)
+		{
+			madvise(const_cast<void*>(data), size, MADV_SEQUENTIAL);
+			madvise(const_cast<void*>(data), size, MADV_WILLNEED);
+		}
+	}
 }// namespace Trinex::Platform
@@ -4,6 +4,7 @@
 #include <Core/types/uuid.hpp>
 #include <Platform/platform.hpp>
 #include <rpc.h>
+#include <windows.h>
 
 #ifdef _MSC_VER
 #	pragma comment(lib, "Rpcrt4.lib")
@@ -55,4 +56,52 @@ namespace Trinex::Platform
 			return Path("./");
 		return Path(argv[0]).base_path();
 	}
+
+	ENGINE_EXPORT const void* map_file(const Path& path, usize& size)
+	{
+		size = 0;
+
+		HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+		                          nullptr);
+
+		if (file == INVALID_HANDLE_VALUE)
+			return nullptr;
+
+		LARGE_INTEGER file_size;
+
+		if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart <= 0)
+		{
+			CloseHandle(file);
+			return nullptr;
+		}
+
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		CloseHandle(file);
+
+		if (mapping == nullptr)
+			return nullptr;
+
+		// View keeps the mapping alive after the handles are closed
+		void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		CloseHandle(mapping);
+
+		if (data == nullptr)
+			return nullptr;
+
+		size = static_cast<usize>(file_size.QuadPart);
+		return data;
+	}
+
+	ENGINE_EXPORT void unmap_file(const void* data, usize size)
+	{
+		if (data)
+		{
+			UnmapViewOfFile(data);
+		}
+	}
+
+	ENGINE_EXPORT void advise_sequential_read(const void* data, usize size)
+	{
+		// Views of files are read ahead by the cache manager, there is nothing to hint
+	}
 }// namespace Trinex::Platform
@@ -19,7 +19,7 @@ namespace Trinex
 
 	u64 RHISamplerDesc::hash() const
 	{
-		return memory_hash(this, sizeof(RHISamplerDesc));
+		return memory_hash_fast(this, sizeof(RHISamplerDesc));
 	}
 
 	bool RHISamplerDesc::operator==(const RHISamplerDesc& initializer) const
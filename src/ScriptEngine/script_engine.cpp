@@ -1,5 +1,6 @@
 #include <Core/etl/array.hpp>
 #include <Core/etl/templates.hpp>
+#include <Core/memory_tracker.hpp>
 #include <Core/stacktrace.hpp>
 #include <Core/string_functions.hpp>
 #include <ScriptEngine/script.hpp>
@@ -90,6 +91,7 @@ namespace Trinex
 
 	static void* angel_script_allocate(usize size)
 	{
+		trinex_memory_tag(Script);
 		return ByteAllocator::allocate(size);
 	}
 